@@ -0,0 +1,107 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <iostream>
+#include <cstdint>
+#include <vector>
+#include "board.hpp"
+
+#ifndef BINARYBOARD_SERIALIZER
+#define BINARYBOARD_SERIALIZER
+// Compact binary save format.  All integers are little-endian.
+//
+//   offset  size  field
+//   0       4     magic "MSWB"
+//   4       2     version (currently 1)
+//   6       2     reserved (0)
+//   8       4     rows
+//   12      4     columns
+//   16      4     mines
+//   20      R*C   tiles, row-major, one byte each:
+//                   bits 0-2 state, bit 3 isMine, bits 4-7 adjacentMines
+//   20+R*C  4     FNV-1a checksum of the tile bytes
+//
+// save() issues a single write and load() a header read plus a single bulk
+// read.  load() validates everything before touching the board, so a bad or
+// truncated file leaves the board unchanged.
+class BinaryBoardSerializer : public ISerializable {
+public:
+    static const uint16_t VERSION = 1;
+
+    BinaryBoardSerializer() = default;
+    ~BinaryBoardSerializer() override = default;
+
+    // @return 0 on success, -1 if the stream failed
+    int save(Board& board, std::ostream& out) override;
+
+    // @return 0 on success, -1 on bad magic/version/dimensions, truncation or checksum
+    int load(Board& board, std::istream& in) override;
+
+    // The format itself, for any board type (Board, FixedBoard; see IsBoard).
+    // read() also fails (-1) when the file does not fit the board.
+    template <class B> static int write(B& board, std::ostream& out);
+    template <class B> static int read(B& board, std::istream& in);
+
+private:
+    static constexpr size_t HEADER_SIZE = 20;
+
+    // Fill in the header and trailing checksum around already encoded tiles
+    static void frame(std::vector<char>& buffer, int rows, int columns, int mines);
+
+    // Read and validate header, tiles and checksum; the board is not touched.
+    // On success `payload` holds rows*columns encoded tiles.
+    static int readPayload(std::istream& in, int& rows, int& columns, int& mines, std::vector<char>& payload);
+
+    static char encode(const Tile& tile) {
+        return static_cast<char>(tile.state | (tile.isMine << 3) | (tile.adjacentMines << 4));
+    }
+};
+
+template <class B>
+int BinaryBoardSerializer::write(B& board, std::ostream& out) {
+    static_assert(IsBoard<B>::value, "BinaryBoardSerializer: not a board type");
+    int rows = board.getRows(), columns = board.getColumns();
+    size_t cells = static_cast<size_t>(rows) * columns;
+    std::vector<char> buffer(HEADER_SIZE + cells + 4);
+
+    // Tiles, one row at a time (each row is contiguous in the board)
+    char* p = &buffer[HEADER_SIZE];
+    for (int r = 0; r < rows; r++) {
+        const Tile* row = board.getTile(r, 0);
+        for (int c = 0; c < columns; c++) {
+            *p++ = encode(row[c]);
+        }
+    }
+    frame(buffer, rows, columns, board.getMines());
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return out ? 0 : -1;
+}
+
+template <class B>
+int BinaryBoardSerializer::read(B& board, std::istream& in) {
+    static_assert(IsBoard<B>::value, "BinaryBoardSerializer: not a board type");
+    int rows, columns, mines;
+    std::vector<char> payload;
+    if (readPayload(in, rows, columns, mines, payload) != 0 || !board.fits(rows, columns, mines)) {
+        return -1;
+    }
+
+    board.clear(rows, columns, mines);
+    const char* p = payload.data();
+    for (int r = 0; r < rows; r++) {
+        Tile* row = board.getTile(r, 0);
+        for (int c = 0; c < columns; c++) {
+            uint8_t byte = static_cast<uint8_t>(*p++);
+            row[c].state = static_cast<TileState>(byte & 0x7);
+            row[c].isMine = (byte >> 3) & 1;
+            row[c].adjacentMines = byte >> 4;
+        }
+    }
+    return 0; // success
+}
+#endif
@@ -10,8 +10,16 @@
 #include <fstream>
 #include <vector>
 #include <memory>
+#include <random>
+#include <array>
+#include <cstdint>
+#include <type_traits>
 #include "tile_state.hpp"
 #include "tile.hpp"
+#include "mine_bitboard.hpp"
+#include "tile_storage.hpp"
+#include "board_stats.hpp"
+#include "move_history.hpp"
 
 using namespace std;
 
@@ -19,6 +27,43 @@ using namespace std;
 #define BOARD
 // Forward-declare Board so the interface can reference it
 class Board;
+class ThreadPool;
+
+// A (row,col) position on the board
+struct Cell {
+    int row;
+    int col;
+};
+
+// Player actions that change a board (used by move journals)
+enum MoveType : uint8_t {
+    MOVE_REVEAL,
+    MOVE_TOGGLE,
+    MOVE_CHORD
+};
+
+// One player action at (row,col)
+struct Move {
+    MoveType type;
+    int row;
+    int col;
+};
+
+// One entry of the diff Board::apply() returns: the tile at row-major index
+// (row * columns + col) now has `state`.  adjacentMines is only filled in for
+// REVEALED tiles (0 otherwise), so a diff never gives away hidden tiles.
+struct TileChange {
+    int32_t index;
+    TileState state;
+    uint8_t adjacentMines;
+};
+
+// What the first reveal of a game is guaranteed not to hit
+enum FirstClickPolicy : uint8_t {
+    FIRST_CLICK_ANY,        // classic: the first click can be a mine
+    FIRST_CLICK_SAFE,       // the clicked tile is never a mine
+    FIRST_CLICK_OPENING     // neither the clicked tile nor its neighbors (opens a cascade)
+};
 
 // Serializer interface: DI target
 struct ISerializable {
@@ -39,6 +84,15 @@ class Board {
         // Main Constructor
         Board(int rows, int columns, int mines, std::shared_ptr<ISerializable> serializer);
 
+        // Seeded constructors: the same seed always produces the same mine layout
+        // (the unseeded constructors draw a seed from std::random_device).
+        Board(int rows, int columns, int mines, uint64_t seed);
+        Board(int rows, int columns, int mines, uint64_t seed, std::shared_ptr<ISerializable> serializer);
+
+        // Board with exactly the given mines (e.g. a NoGuessGenerator layout);
+        // the mine count is mines.size()
+        Board(int rows, int columns, const vector<Cell>& mines);
+
         // Create Board from a stream (file).  This not the same as restoring a game 
         // from a file (see load() method).  This is used to create repeatable starting
         // boards that make testing simpler.
@@ -54,33 +108,173 @@ class Board {
         int getMines() const;
 
         // @return tag state for tile at (row,col)
+        // The pointer stays valid until the board is reset or reloaded.  Each
+        // row is contiguous (getTile(r, 0) is a row pointer), but rows are not
+        // adjacent to each other: the grid carries a sentinel border.
+        // NOTE: use revealTile/toggleTile to change state; writing through the
+        // pointer bypasses the game-state counters below.
         Tile* getTile(int row, int col);
 
+        // @return true once every non-mine tile has been revealed (O(1))
+        bool isWon() const;
+
+        // @return true if a mine has exploded (O(1))
+        bool isLost() const;
+
+        // @return mines minus flags placed; negative when over-flagged (O(1))
+        int minesRemaining() const;
+
+        // @return tiles opened so far: revealed ones plus exploded mines (O(1))
+        int revealedTiles() const;
+
         // Reveal logic:
         // - If tile is FLAGGED/QUESTIONED/REVEALED: do nothing
         // - If tile is a mine: returns 1 to indicate explosion (the caller can handle game over
         //   (NOTE: function is also used for auto-spread after a safe click).
         // - If tile has adjacentMines > 0: reveal it and stop
-        // - If tile has adjacentMines == 0: reveal it and recursively reveal neighbors
+        // - If tile has adjacentMines == 0: reveal it and flood-fill its neighbors
+        //   (iterative, each tile is visited at most once)
         // @return true if a mine was revealed (explosion), 0 otherwise
         bool revealTile(int row, int col);
 
+        // Same as revealTile(row, col), but also appends every tile whose state
+        // changed (REVEALED or EXPLODED) to `revealed`.  The buffer is not cleared,
+        // so callers can reuse it across calls without reallocating.
+        // @return true if a mine was revealed (explosion), 0 otherwise
+        bool revealTile(int row, int col, vector<Cell>& revealed);
+
+        // Chord: on a revealed number whose flagged neighbors match its count,
+        // reveal every other covered neighbor (QUESTIONED ones stay, as with
+        // revealTile).  Empty neighbors share one flood fill.  Anything else
+        // does nothing.
+        // @return true if a mine was revealed (a flag was wrong), 0 otherwise
+        bool chordTile(int row, int col);
+
+        // Same as chordTile(row, col), but also appends every tile whose state
+        // changed to `revealed` (not cleared, as with revealTile)
+        // @return true if a mine was revealed (a flag was wrong), 0 otherwise
+        bool chordTile(int row, int col, vector<Cell>& revealed);
+
+        // Apply a batch of moves in order, as if each were a revealTile,
+        // toggleTile or chordTile call (each is its own undo step), and
+        // report the net effect: one entry per tile whose state differs from
+        // before the batch, in the order tiles were first changed.  A tile
+        // flagged and unflagged within the batch does not appear.
+        // The diff lives in a buffer the board reuses, so a warmed-up board
+        // applies batches without allocating; it is valid until the next
+        // apply() (or until the board is destroyed).
+        // @return the diff
+        const vector<TileChange>& apply(const Move* moves, size_t count);
+        const vector<TileChange>& apply(const vector<Move>& moves);
+
         // Toggles tile state: COVERED -> FLAGGED -> QUESTIONED -> COVERED
         // @return The TileState after toggle
         TileState toggleTile(int row, int col);
         
+        // Choose what the first reveal of each game is protected from.  Mines in
+        // the way are moved to random free tiles when that reveal happens, and
+        // only the counts around the old and new positions are updated (O(1)).
+        // The policy is a play option: it survives reset() but is not saved.
+        void setFirstClick(FirstClickPolicy policy);
+
+        // @return the current first-click policy (FIRST_CLICK_ANY by default)
+        FirstClickPolicy getFirstClick() const;
+
+        // Keep the last `depth` revealTile/toggleTile moves for undo()/redo()
+        // (0, the default, records nothing).  Each move stores only the tiles
+        // it changed, so undo and redo cost O(tiles changed) even after a big
+        // cascade.  Like the first-click policy, the depth survives reset();
+        // reset()/load()/attach() forget the recorded moves.
+        void setUndoDepth(size_t depth);
+
+        // @return the number of moves kept for undo/redo
+        size_t getUndoDepth() const;
+
+        // Take back the last recorded move (a first reveal's mine moves
+        // included).  Moves made afterwards discard the redo moves.
+        // @return false if there is nothing to undo
+        bool undo();
+
+        // Same as undo(), but also appends every tile it changed to `changed`
+        bool undo(vector<Cell>& changed);
+
+        // Replay the last undone move
+        // @return false if there is nothing to redo
+        bool redo();
+
+        // Same as redo(), but also appends every tile it changed to `changed`
+        bool redo(vector<Cell>& changed);
+
+        // @return number of moves that undo() / redo() can step over
+        size_t undoable() const;
+        size_t redoable() const;
+
         // Save game state to a stream
         int save(ostream& in);
 
         // Load game state from a stream
         int load(istream& out);
+
+        // Zero-copy load: mmap a file written by MappedBoardSerializer and use
+        // it directly as this board's tiles (no copy).  The game-state
+        // counters are rebuilt from the tiles rather than trusted from the
+        // header, so every page is read once.
+        // With inPlace the mapping is shared, so every move is
+        // written straight into the file; otherwise the file is never changed
+        // (pages are copied on first write).  reset()/load() detach again.
+        // @return 0 on success, -1 if the file cannot be mapped or is not valid
+        int attach(const string& path, bool inPlace);
+
+        // For an in-place attached board: store the game-state counters in the
+        // file header and flush dirty pages to disk.  No-op otherwise.
+        // @return 0 on success, -1 on failure
+        int sync();
+
+        // @return true if the tiles live in a mapped file
+        bool isAttached() const;
+
+        // @return a snapshot of the instrumentation counters and timers
+        // (all zeros unless built with MINESWEEPER_STATS=ON, see BoardStats).
+        // Counters cover the board's lifetime; reset()/load() do not clear them.
+        BoardStats stats() const;
+
+        // Zero the instrumentation counters and timers
+        void resetStats();
     
         // @return  true if (row,col) is within bounds of the board, false otherwise
         bool inBounds(int row, int col) const;
     
         // Reset the board to initial state (with mines laid out)
+        // Mines are drawn from the board's own generator, so consecutive resets differ.
         void reset(int rows, int cols, int mines);
 
+        // Reset the board and reseed its generator, giving a reproducible layout
+        void reset(int rows, int cols, int mines, uint64_t seed);
+
+        // Parallel generation for huge boards.  The board is cut into bands
+        // of rows; each band draws its mines from its own counter-based
+        // stream keyed by (seed, band), and its adjacent counts are computed
+        // with a one-row halo from the bands next to it.  The layout depends
+        // only on the size and seed, never on the thread count (a null pool
+        // runs every band on the calling thread), but it is not the layout
+        // reset(rows, cols, mines, seed) gives.
+        void reset(int rows, int cols, int mines, uint64_t seed, ThreadPool* pool);
+
+        // Reset the board to exactly the given mines (no duplicates)
+        void reset(int rows, int cols, const vector<Cell>& mines);
+
+        // Resize to an all-covered board with no mines placed and no counts.
+        // For serializers that write every tile themselves (see load()).
+        void clear(int rows, int cols, int mines);
+
+        // Make room for a rows x cols board (tiles and the reveal queue), so
+        // reset() up to that size reuses the buffers.  See BoardPool.
+        void reserve(int rows, int cols);
+
+        // @return true if this board can take on the given size (anything
+        // non-empty with at most one mine per tile; FixedBoard only its own)
+        static bool fits(int rows, int cols, int mines);
+
         // Overload output operator for Board for debugging only
         // Shows all tiles regardless of state (e.g., covered tiles are shown)
         friend ostream& operator<<(ostream& out, const Board& board);
@@ -88,22 +282,161 @@ class Board {
         // Overload the equality operator for testing purposes
         friend bool operator==(const Board& b1, const Board& b2);
 
+        // Writes/reads the tile array byte-for-byte
+        friend class MappedBoardSerializer;
+
     
     private:
         int rows;
         int columns;
         int mines;
 
-        vector<vector<Tile>> tiles;
+        // Row-major, one byte per tile, with a one-tile sentinel border: tile
+        // (r,c) lives at tiles[(r + 1) * stride + c + 1].  Border tiles are
+        // REVEALED non-mines, so the flood fill stops at them without a bounds
+        // check.  Owned, or borrowed from a mapped save file (see attach()).
+        TileStorage tiles;
+
+        // Tiles per stored row (columns + 2)
+        int stride = 2;
+
+        // ceil(2^32 / columns), for interior()
+        uint64_t columnsReciprocal = 0;
+
+        // Linear offsets of the 8 neighbors of a tile in `tiles`
+        array<int, 8> neighborOffsets{};
+
+        // Mine bit-planes used to count adjacent mines (kept to reuse its buffers)
+        MineBitboard mineBits;
+
+        // Work queue reused by the reveal flood fill (indices of tiles still to expand)
+        vector<int> floodQueue;
+
+        // Game-state counters, kept up to date by reveal/toggle/reset/load
+        int revealedSafe = 0;
+        int flagged = 0;
+        int questioned = 0;
+        int exploded = 0;
+
+        FirstClickPolicy firstClick = FIRST_CLICK_ANY;
+
+        // Recorded moves for undo()/redo() (off unless setUndoDepth())
+        MoveHistory history;
+
+        // apply() state: while `batching`, each tile changed for the first
+        // time gets its bit set in batchSeen (one bit per entry of `tiles`,
+        // all clear between batches) and an entry in batchDiff
+        bool batching = false;
+        vector<uint64_t> batchSeen;
+        vector<TileChange> batchDiff;
+
+#ifdef MS_ENABLE_STATS
+        BoardStats statsData;
+#endif
+
+        // Mine placement generator (seeded per board, no global rand() state)
+        std::mt19937_64 rng;
 
         // Injected dependency (shared_ptr lets you reuse a stateless singleton)
         std::shared_ptr<ISerializable> serializer;
 
-        // Randomly place mines and calculate adjacent mine counts
+        // @return index of (row,col) in tiles
+        int index(int row, int col) const { return (row + 1) * this->stride + col + 1; }
+
+        // @return (row,col) of index i in tiles
+        Cell cell(int i) const { return {i / this->stride - 1, i % this->stride - 1}; }
+
+        // @return index in tiles of the i-th tile in row-major order (no border)
+        // Mine laying calls this twice per mine, so the row comes from a
+        // fixed-point reciprocal (high by at most one, then corrected)
+        // instead of a division.
+        int interior(int i) const {
+            int row = static_cast<int>((static_cast<uint64_t>(i) * this->columnsReciprocal) >> 32);
+            row -= row * this->columns > i;
+            return i + 2 * row + this->stride + 1;
+        }
+
+        // Set rows/columns/mines and the stride and neighbor offsets
+        void shape(int rows, int cols, int mines);
+
+        // @return true if a (rows+2) x (columns+2) tile array has an intact
+        // sentinel border (checked before borrowing tiles from a file)
+        static bool bordered(const Tile* tiles, int rows, int columns);
+
+        // Randomly place exactly `mines` mines (Floyd's sampling, O(mines))
         void layMines();
 
         // Calculate adjacent mine counts for all tiles
         void calculateAdjacents();
+
+        // Banded layMines() + calculateAdjacents() (see the pool reset())
+        void generateBands(uint64_t seed, ThreadPool* pool);
+
+        // Apply the first-click policy to a first reveal at (row,col)
+        void protectFirstClick(int row, int col);
+
+        // Move the mine at tile index `from` to the free tile `to`, updating
+        // the adjacent counts of both neighborhoods
+        void moveMine(int from, int to);
+
+        // Shared reveal/chord implementations; `revealed` may be null
+        bool reveal(int row, int col, vector<Cell>* revealed);
+        bool chord(int row, int col, vector<Cell>* revealed);
+
+        // Reveal the covered tile tiles[i]; queue it for flood() if it is empty
+        // @return true if it was a mine
+        bool open(int i, vector<Cell>* revealed);
+
+        // Breadth-first reveal outward from the empty tiles in floodQueue
+        void flood(vector<Cell>* revealed);
+
+        // Note tiles[i] in the move being recorded and in the batch being
+        // applied, before it is written
+        void note(int i) {
+            if (this->history.enabled()) this->history.note(i, this->tiles[i]);
+            if (this->batching) {
+                uint64_t bit = uint64_t{1} << (i & 63);
+                if (!(this->batchSeen[i >> 6] & bit)) {
+                    this->batchSeen[i >> 6] |= bit;
+                    this->batchDiff.push_back({i, this->tiles[i].state, 0});
+                }
+            }
+        }
+
+        // Write recorded tile bytes back (undo: `before`, last change first;
+        // redo: `after`, first change first), keeping the counters in step
+        void replay(const MoveHistory::Change* first, size_t count, bool forward, vector<Cell>* changed);
+
+        // Move the game-state counter of `state` by `delta`
+        void tally(TileState state, int delta);
+
+        // Rebuild the game-state counters from the tiles (after a load)
+        void recount();
 };
 
+// The interface Board and FixedBoard share (C++17 stand-in for a concept).
+// Code that works with either board (serializers, the TUI) is a template on
+// the board type and checks it with static_assert(IsBoard<B>::value).
+// Tiles must be row-major with each row contiguous: getTile(r, 0) is a row
+// pointer (rows themselves need not be adjacent).
+template <class B, class = void>
+struct IsBoard : std::false_type {};
+
+template <class B>
+struct IsBoard<B, std::void_t<
+    decltype(std::declval<B&>().getRows()),
+    decltype(std::declval<B&>().getColumns()),
+    decltype(std::declval<B&>().getMines()),
+    std::enable_if_t<std::is_same<decltype(std::declval<B&>().getTile(0, 0)), Tile*>::value>,
+    decltype(std::declval<B&>().revealTile(0, 0)),
+    decltype(std::declval<B&>().revealTile(0, 0, std::declval<vector<Cell>&>())),
+    decltype(std::declval<B&>().toggleTile(0, 0)),
+    decltype(std::declval<B&>().isWon()),
+    decltype(std::declval<B&>().isLost()),
+    decltype(std::declval<B&>().minesRemaining()),
+    decltype(std::declval<B&>().inBounds(0, 0)),
+    decltype(std::declval<B&>().fits(0, 0, 0)),
+    decltype(std::declval<B&>().clear(0, 0, 0)),
+    decltype(std::declval<B&>().reset(0, 0, 0))>> : std::true_type {};
+
 #endif // BOARD
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "board.hpp"
+
+using namespace std;
+
+#ifndef BOARD_POOL
+#define BOARD_POOL
+// Recycles Boards for code that starts and ends games all the time (the game
+// server, bots).  Boards are handed out by size class - the tile count
+// rounded up to a power of two - and go back to the free list of the class
+// they have when the handle is dropped (a board reset or loaded to another
+// size changes class).  A recycled board is reset in place: its tile
+// buffer, mine bit-planes and flood queue already have the capacity, so
+// acquiring one allocates nothing.  Every board lives in the pool's arena (a
+// deque, so boards never move) until the pool is destroyed.
+//
+// A board from the pool behaves like a new one: first-click policy ANY, no
+// undo, default serializer.  Only stats() (lifetime counters) carry over.
+// Thread-safe; the pool must outlive its handles.
+class BoardPool {
+    public:
+        // Puts a board back in the pool (the handle's deleter)
+        struct Release {
+            BoardPool* pool = nullptr;
+            void operator()(Board* board) const;
+        };
+        using Handle = unique_ptr<Board, Release>;
+
+        BoardPool() = default;
+        BoardPool(const BoardPool&) = delete;
+        BoardPool& operator=(const BoardPool&) = delete;
+
+        // A freshly laid board; the same seed gives the same layout as
+        // Board(rows, columns, mines, seed).  Sizes must satisfy Board::fits.
+        Handle acquire(int rows, int columns, int mines, uint64_t seed);
+        Handle acquire(int rows, int columns, int mines);
+
+        // Make sure at least `count` boards of this size class are idle, with
+        // room for rows x columns (buffers allocated and touched)
+        void reserve(int rows, int columns, size_t count);
+
+        // @return boards owned by the pool (in use or idle) / idle
+        size_t size() const;
+        size_t idle() const;
+
+        // @return the size class of a rows x columns board
+        static int sizeClass(int rows, int columns);
+
+    private:
+        mutable mutex lock;
+        deque<Board> arena;
+        array<vector<Board*>, 64> idleBoards;
+
+        // Pop an idle board of the class (or add one to the arena) and make
+        // room for rows x columns in it
+        Board* take(int sizeClass, int rows, int columns);
+};
+#endif
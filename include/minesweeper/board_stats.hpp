@@ -0,0 +1,67 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+#ifndef BOARD_STATS
+#define BOARD_STATS
+// Instrumentation collected by a Board over its lifetime (see Board::stats()).
+// Only gathered when the library is built with MINESWEEPER_STATS=ON, which
+// defines MS_ENABLE_STATS; otherwise every hook compiles to nothing and the
+// snapshot is all zeros with enabled == false.
+struct BoardStats {
+    bool enabled = false;          // built with MS_ENABLE_STATS
+
+    uint64_t reveals = 0;          // revealTile calls
+    uint64_t cascades = 0;         // reveals that started a flood fill
+    uint64_t cascadeTiles = 0;     // tiles opened by flood fills (clicked tile included)
+    uint64_t maxCascadeTiles = 0;  // largest single flood fill
+    uint64_t maxCascadeDepth = 0;  // most BFS rings spread by a single flood fill
+    uint64_t tilesTouched = 0;     // tiles read by revealTile calls
+    uint64_t maxTilesTouched = 0;  // most tiles read by one revealTile call
+    uint64_t toggles = 0;          // toggleTile calls
+
+    uint64_t saves = 0;
+    uint64_t loads = 0;
+    uint64_t bytesSaved = 0;       // stream bytes written by save() (when the stream can tell)
+    uint64_t bytesLoaded = 0;      // stream bytes consumed by load() (when the stream can tell)
+
+    // Wall time, nanoseconds
+    uint64_t revealNs = 0;
+    uint64_t adjacentsNs = 0;      // calculateAdjacents (constructors, reset, load)
+    uint64_t saveNs = 0;
+    uint64_t loadNs = 0;
+};
+
+#ifdef MS_ENABLE_STATS
+// Adds the lifetime of the enclosing scope to `sink`, in nanoseconds
+class StatsTimer {
+    public:
+        explicit StatsTimer(uint64_t& sink) : sink(sink), start(chrono::steady_clock::now()) {}
+        ~StatsTimer() {
+            this->sink += static_cast<uint64_t>(
+                chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - this->start).count());
+        }
+        StatsTimer(const StatsTimer&) = delete;
+        StatsTimer& operator=(const StatsTimer&) = delete;
+
+    private:
+        uint64_t& sink;
+        chrono::steady_clock::time_point start;
+};
+
+#define MS_STATS(...) __VA_ARGS__
+#define MS_STATS_TIMER(sink) StatsTimer statsTimer(sink)
+#else
+#define MS_STATS(...)
+#define MS_STATS_TIMER(sink)
+#endif
+
+#endif // BOARD_STATS
@@ -0,0 +1,111 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "tile.hpp"
+#include "board.hpp"
+
+using namespace std;
+
+#ifndef CHUNKED_BOARD
+#define CHUNKED_BOARD
+// Sparse board for very large or endless playfields.
+//
+// Tiles live in fixed CHUNK_SIZE x CHUNK_SIZE chunks that are created the first
+// time one of their tiles is touched.  Whether a tile is a mine is a pure hash
+// of (seed, chunk coordinates, position in chunk), so any chunk -- and the halo
+// of its neighbors needed for adjacent counts -- can be rebuilt on demand and
+// untouched areas cost no memory.  Chunks nobody has modified can be evicted
+// and will be regenerated identically.
+//
+// revealTile/toggleTile behave exactly like Board's.  Note that the density
+// should stay well above the percolation point (any classic preset does) on
+// endless boards, otherwise a single empty click may cascade indefinitely.
+class ChunkedBoard {
+    public:
+        static const int CHUNK_SIZE = 64;
+
+        // rows/columns bound the playfield (use INT_MAX for "endless").
+        // density is the probability that a tile is a mine, in [0, 1].
+        ChunkedBoard(int rows, int columns, double density, uint64_t seed);
+
+        // @return number of rows
+        int getRows() const;
+
+        // @return number of columns
+        int getColumns() const;
+
+        // @return tile at (row,col), creating its chunk if needed.
+        // The pointer stays valid until that chunk is evicted.
+        Tile* getTile(int row, int col);
+
+        // Same rules as Board::revealTile (iterative flood fill)
+        // @return true if a mine was revealed (explosion), false otherwise
+        bool revealTile(int row, int col);
+
+        // Same as revealTile(row, col), also appends every tile that changed
+        bool revealTile(int row, int col, vector<Cell>& revealed);
+
+        // Toggles tile state: COVERED -> FLAGGED -> QUESTIONED -> COVERED
+        // @return The TileState after toggle
+        TileState toggleTile(int row, int col);
+
+        // @return  true if (row,col) is within bounds of the board, false otherwise
+        bool inBounds(int row, int col) const;
+
+        // @return true if a mine has exploded
+        bool isLost() const;
+
+        // @return number of safe tiles revealed so far
+        long long getRevealedCount() const;
+
+        // @return number of chunks currently held in memory
+        size_t chunkCount() const;
+
+        // Drop every chunk whose tiles were never changed by the player
+        // @return number of chunks evicted
+        size_t evictClean();
+
+    private:
+        struct Chunk {
+            array<Tile, CHUNK_SIZE * CHUNK_SIZE> tiles;
+            bool dirty = false;     // true once any tile state changed
+        };
+
+        int rows;
+        int columns;
+        uint64_t mineThreshold;     // hash < threshold means mine
+        uint64_t seed;
+
+        unordered_map<uint64_t, unique_ptr<Chunk>> chunks;
+
+        // Work queue reused by the reveal flood fill
+        vector<Cell> floodQueue;
+
+        long long revealedSafe = 0;
+        int exploded = 0;
+
+        // @return key for the chunk containing (row,col)
+        static uint64_t chunkKey(int chunkRow, int chunkCol);
+
+        // @return true if (row,col) holds a mine, without creating any chunk
+        bool mineAt(int row, int col) const;
+
+        // @return the chunk holding (row,col), generating it if needed
+        Chunk& chunkFor(int row, int col);
+
+        // Fill a fresh chunk's mines and adjacent counts
+        void generate(Chunk& chunk, int chunkRow, int chunkCol) const;
+
+        // Shared reveal implementation; `revealed` may be null
+        bool reveal(int row, int col, vector<Cell>* revealed);
+};
+#endif
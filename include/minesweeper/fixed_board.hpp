@@ -0,0 +1,463 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "board.hpp"
+#include "text_board_serializer.hpp"
+
+using namespace std;
+
+#ifndef FIXED_BOARD
+#define FIXED_BOARD
+// A board whose size is fixed at compile time, for the classic presets.
+//
+// Same interface as Board (see IsBoard), so the serializers' write()/read()
+// and the TUI work with either, but nothing is allocated: the tiles, the
+// flood-fill queue and the generator live inside the object.  Neighbors come
+// from a constexpr table of 8 tile indices per tile; off-board neighbors
+// point at a sentinel tile past the end that is never a mine and never
+// covered, so every neighbor loop runs exactly 8 times with no bounds checks.
+//
+// Mines are laid exactly like Board's, so FixedBoard<R, C, M>(seed) and
+// Board(R, C, M, seed) start from the same layout.  Saving uses the text
+// format (TextBoardSerializer); there is no serializer injection.
+template <int R, int C, int M>
+class FixedBoard {
+    static_assert(R > 0 && C > 0, "FixedBoard: empty board");
+    static_assert(M >= 0 && M <= R * C, "FixedBoard: too many mines");
+    static_assert(R * C < UINT16_MAX, "FixedBoard: tile indices must fit in 16 bits");
+
+    public:
+        static constexpr int ROWS = R;
+        static constexpr int COLUMNS = C;
+        static constexpr int MINES = M;
+        static constexpr int CELLS = R * C;
+
+        // Random layout (seed drawn from std::random_device)
+        FixedBoard();
+
+        // Seeded: the same seed always produces the same layout
+        explicit FixedBoard(uint64_t seed);
+
+        // Exactly the given mines (there must be M of them, no duplicates)
+        explicit FixedBoard(const vector<Cell>& mines);
+
+        int getRows() const { return R; }
+        int getColumns() const { return C; }
+        int getMines() const { return M; }
+
+        // @return tile at (row,col); rows are contiguous, as in Board
+        Tile* getTile(int row, int col);
+
+        bool isWon() const { return this->exploded == 0 && this->revealedSafe == CELLS - M; }
+        bool isLost() const { return this->exploded > 0; }
+        int minesRemaining() const { return M - this->flagged; }
+
+        // Same rules as Board::revealTile
+        bool revealTile(int row, int col);
+        bool revealTile(int row, int col, vector<Cell>& revealed);
+
+        // Same rules as Board::toggleTile
+        TileState toggleTile(int row, int col);
+
+        void setFirstClick(FirstClickPolicy policy) { this->firstClick = policy; }
+        FirstClickPolicy getFirstClick() const { return this->firstClick; }
+
+        // Text format, as TextBoardSerializer writes it for a Board
+        // @return 0 on success, -1 if the stream does not hold an R x C board with M mines
+        int save(ostream& out);
+        int load(istream& in);
+
+        bool inBounds(int row, int col) const {
+            return row >= 0 && row < R && col >= 0 && col < C;
+        }
+
+        // @return true only for this board's own size
+        bool fits(int rows, int cols, int mines) const { return rows == R && cols == C && mines == M; }
+
+        // New layout from the board's generator / from a new seed / as given
+        void reset();
+        void reset(uint64_t seed);
+        void reset(const vector<Cell>& mines);
+
+        // Board-compatible forms; the size must be this board's (asserted)
+        void reset(int rows, int cols, int mines);
+        void clear(int rows, int cols, int mines);
+
+        template <int R2, int C2, int M2>
+        friend bool operator==(const FixedBoard<R2, C2, M2>& b1, const FixedBoard<R2, C2, M2>& b2);
+
+    private:
+        static constexpr int SENTINEL = CELLS;
+
+        // NEIGHBORS[i] = the 8 neighbors of tile i, SENTINEL where off the board
+        using NeighborTable = array<array<uint16_t, 8>, CELLS>;
+        static constexpr NeighborTable makeNeighbors() {
+            NeighborTable table{};
+            for (int r = 0; r < R; r++) {
+                for (int c = 0; c < C; c++) {
+                    int k = 0;
+                    for (int dr = -1; dr <= 1; dr++) {
+                        for (int dc = -1; dc <= 1; dc++) {
+                            if (dr == 0 && dc == 0) continue;
+                            int nr = r + dr, nc = c + dc;
+                            bool on = nr >= 0 && nr < R && nc >= 0 && nc < C;
+                            table[r * C + c][k++] = static_cast<uint16_t>(on ? nr * C + nc : SENTINEL);
+                        }
+                    }
+                }
+            }
+            return table;
+        }
+        static constexpr NeighborTable NEIGHBORS = makeNeighbors();
+
+        // Row-major tiles plus the sentinel at [CELLS]
+        array<Tile, CELLS + 1> tiles;
+
+        // Flood-fill queue (each tile enters at most once)
+        array<uint16_t, CELLS> floodQueue;
+
+        int revealedSafe = 0;
+        int flagged = 0;
+        int questioned = 0;
+        int exploded = 0;
+
+        FirstClickPolicy firstClick = FIRST_CLICK_ANY;
+
+        std::mt19937_64 rng;
+
+        // Fresh 64-bit seed for boards created without one
+        static uint64_t randomSeed() {
+            std::random_device device;
+            return (static_cast<uint64_t>(device()) << 32) ^ device();
+        }
+
+        void clearTiles();
+        void layMines();
+        void calculateAdjacents();
+        void protectFirstClick(int row, int col);
+        void moveMine(int from, int to);
+        bool reveal(int row, int col, vector<Cell>* revealed);
+        void recount();
+};
+
+// The three classic presets
+using BeginnerBoard = FixedBoard<9, 9, 10>;
+using IntermediateBoard = FixedBoard<16, 16, 40>;
+using ExpertBoard = FixedBoard<16, 30, 99>;
+
+template <int R, int C, int M>
+FixedBoard<R, C, M>::FixedBoard() : FixedBoard(randomSeed()) {}
+
+template <int R, int C, int M>
+FixedBoard<R, C, M>::FixedBoard(uint64_t seed) : rng(seed) {
+    this->reset();
+}
+
+template <int R, int C, int M>
+FixedBoard<R, C, M>::FixedBoard(const vector<Cell>& mines) : rng(randomSeed()) {
+    this->reset(mines);
+}
+
+template <int R, int C, int M>
+Tile* FixedBoard<R, C, M>::getTile(int row, int col) {
+    assert(inBounds(row, col) && "getTile: (row,col) out of bounds");
+    return &this->tiles[row * C + col];
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::clearTiles() {
+    this->tiles.fill(Tile());
+    this->tiles[SENTINEL].state = TileState::REVEALED;
+    this->revealedSafe = this->flagged = this->questioned = this->exploded = 0;
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::reset() {
+    this->clearTiles();
+    this->layMines();
+    this->calculateAdjacents();
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::reset(uint64_t seed) {
+    this->rng.seed(seed);
+    this->reset();
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::reset(const vector<Cell>& mines) {
+    assert(static_cast<int>(mines.size()) == M && "reset: wrong number of mines");
+    this->clearTiles();
+    for (const Cell& cell : mines) {
+        assert(inBounds(cell.row, cell.col) && "reset: mine out of bounds");
+        Tile& tile = this->tiles[cell.row * C + cell.col];
+        assert(!tile.isMine && "reset: duplicate mine");
+        tile.isMine = true;
+    }
+    this->calculateAdjacents();
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::reset(int rows, int cols, int mines) {
+    assert(fits(rows, cols, mines) && "reset: FixedBoard cannot change size");
+    (void)rows; (void)cols; (void)mines;
+    this->reset();
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::clear(int rows, int cols, int mines) {
+    assert(fits(rows, cols, mines) && "clear: FixedBoard cannot change size");
+    (void)rows; (void)cols; (void)mines;
+    this->clearTiles();
+}
+
+// Floyd's sampling, draw for draw the same as Board::layMines
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::layMines() {
+    for (int j = CELLS - M; j < CELLS; j++) {
+        std::uniform_int_distribution<int> pick(0, j);
+        Tile& tile = this->tiles[pick(this->rng)];
+        if (tile.isMine) {
+            this->tiles[j].isMine = true;
+        } else {
+            tile.isMine = true;
+        }
+    }
+}
+
+// Branch-free: copy the mine bits into a zero-padded byte plane, sum each
+// tile's 8 neighbors at constant offsets (plain byte adds the compiler can
+// vectorize), then store whole tiles from a small lookup table.  Tiles are
+// freshly cleared here, and mines carry no count, as in Board.
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::calculateAdjacents() {
+    struct Lookup {
+        Tile tile[2][9];    // [isMine][count], covered
+        Lookup() {
+            for (int count = 0; count <= 8; count++) {
+                this->tile[0][count].adjacentMines = count;
+                this->tile[1][count].isMine = true;
+            }
+        }
+    };
+    static const Lookup lookup;
+
+    constexpr int W = C + 2;
+    array<uint8_t, (R + 2) * W> plane{};
+    for (int r = 0; r < R; r++) {
+        for (int c = 0; c < C; c++) {
+            plane[(r + 1) * W + c + 1] = this->tiles[r * C + c].isMine;
+        }
+    }
+    array<uint8_t, C> counts;
+    for (int r = 0; r < R; r++) {
+        const uint8_t* m = &plane[(r + 1) * W + 1];
+        for (int c = 0; c < C; c++) {
+            counts[c] = m[c - W - 1] + m[c - W] + m[c - W + 1] + m[c - 1] + m[c + 1] + m[c + W - 1] + m[c + W] + m[c + W + 1];
+        }
+        for (int c = 0; c < C; c++) {
+            this->tiles[r * C + c] = lookup.tile[m[c]][counts[c]];
+        }
+    }
+}
+
+template <int R, int C, int M>
+bool FixedBoard<R, C, M>::revealTile(int row, int col) {
+    return reveal(row, col, nullptr);
+}
+
+template <int R, int C, int M>
+bool FixedBoard<R, C, M>::revealTile(int row, int col, vector<Cell>& revealed) {
+    return reveal(row, col, &revealed);
+}
+
+template <int R, int C, int M>
+bool FixedBoard<R, C, M>::reveal(int row, int col, vector<Cell>* revealed) {
+    assert(inBounds(row, col) && "revealTile: (row,col) out of bounds");
+
+    Tile& tile = this->tiles[row * C + col];
+    if (tile.state == TileState::REVEALED || tile.state == TileState::FLAGGED || tile.state == TileState::QUESTIONED ||
+        tile.state == TileState::EXPLODED) {
+        return false; // do nothing
+    }
+    if (this->firstClick != FIRST_CLICK_ANY && this->revealedSafe == 0 && this->exploded == 0) {
+        protectFirstClick(row, col);
+    }
+    if (tile.isMine) {
+        tile.state = TileState::EXPLODED;
+        this->exploded++;
+        if (revealed) revealed->push_back({row, col});
+        return true; // mine revealed
+    }
+    tile.state = TileState::REVEALED;
+    this->revealedSafe++;
+    if (revealed) revealed->push_back({row, col});
+    if (tile.adjacentMines != 0) {
+        return false;
+    }
+
+    // Breadth-first, as Board; the sentinel is REVEALED so it never spreads
+    int tail = 0;
+    this->floodQueue[tail++] = static_cast<uint16_t>(row * C + col);
+    for (int head = 0; head < tail; head++) {
+        const array<uint16_t, 8>& n = NEIGHBORS[this->floodQueue[head]];
+        for (int k = 0; k < 8; k++) {
+            Tile& neighbor = this->tiles[n[k]];
+            if (neighbor.state != TileState::COVERED || neighbor.isMine) continue;
+            neighbor.state = TileState::REVEALED;
+            this->revealedSafe++;
+            if (revealed) revealed->push_back({n[k] / C, n[k] % C});
+            if (neighbor.adjacentMines == 0) {
+                this->floodQueue[tail++] = n[k];
+            }
+        }
+    }
+    return false; // no mine revealed
+}
+
+template <int R, int C, int M>
+TileState FixedBoard<R, C, M>::toggleTile(int row, int col) {
+    assert(inBounds(row, col) && "toggleTile: (row,col) out of bounds");
+
+    Tile& tile = this->tiles[row * C + col];
+    switch (tile.state) {
+        case TileState::COVERED:
+            tile.state = TileState::FLAGGED;
+            this->flagged++;
+            break;
+        case TileState::FLAGGED:
+            tile.state = TileState::QUESTIONED;
+            this->flagged--;
+            this->questioned++;
+            break;
+        case TileState::QUESTIONED:
+            tile.state = TileState::COVERED;
+            this->questioned--;
+            break;
+        default:
+            // Do nothing for REVEALED or EXPLODED
+            break;
+    }
+    return tile.state;
+}
+
+// Same policy and the same generator draws as Board::protectFirstClick
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::protectFirstClick(int row, int col) {
+    int r0 = row, r1 = row, c0 = col, c1 = col;
+    if (this->firstClick == FIRST_CLICK_OPENING) {
+        r0 = max(0, row - 1);
+        r1 = min(R - 1, row + 1);
+        c0 = max(0, col - 1);
+        c1 = min(C - 1, col + 1);
+        if (CELLS - (r1 - r0 + 1) * (c1 - c0 + 1) < M) {
+            r0 = r1 = row;
+            c0 = c1 = col;
+        }
+    }
+    if (CELLS - 1 < M) {
+        return;
+    }
+    auto protectedTile = [&](int i) {
+        int r = i / C;
+        int c = i % C;
+        return r >= r0 && r <= r1 && c >= c0 && c <= c1;
+    };
+    std::uniform_int_distribution<int> pick(0, CELLS - 1);
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            if (!this->tiles[r * C + c].isMine) {
+                continue;
+            }
+            int to = -1;
+            for (int tries = 0; tries < 64 && to < 0; tries++) {
+                int i = pick(this->rng);
+                if (!this->tiles[i].isMine && !protectedTile(i)) {
+                    to = i;
+                }
+            }
+            for (int k = 0, start = pick(this->rng); k < CELLS && to < 0; k++) {
+                int i = (start + k) % CELLS;
+                if (!this->tiles[i].isMine && !protectedTile(i)) {
+                    to = i;
+                }
+            }
+            moveMine(r * C + c, to);
+        }
+    }
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::moveMine(int from, int to) {
+    Tile& source = this->tiles[from];
+    source.isMine = false;
+    int count = 0;
+    for (uint16_t n : NEIGHBORS[from]) {
+        if (n == SENTINEL) continue;
+        if (this->tiles[n].isMine) {
+            count++;
+        } else {
+            this->tiles[n].adjacentMines--;
+        }
+    }
+    source.adjacentMines = count;
+
+    Tile& target = this->tiles[to];
+    target.isMine = true;
+    target.adjacentMines = 0;
+    for (uint16_t n : NEIGHBORS[to]) {
+        if (n != SENTINEL && !this->tiles[n].isMine) {
+            this->tiles[n].adjacentMines++;
+        }
+    }
+}
+
+template <int R, int C, int M>
+int FixedBoard<R, C, M>::save(ostream& out) {
+    return TextBoardSerializer::write(*this, out);
+}
+
+// The serializer writes tiles directly, so the counters are rebuilt afterwards
+template <int R, int C, int M>
+int FixedBoard<R, C, M>::load(istream& in) {
+    int result = TextBoardSerializer::read(*this, in);
+    this->recount();
+    return result;
+}
+
+template <int R, int C, int M>
+void FixedBoard<R, C, M>::recount() {
+    this->revealedSafe = this->flagged = this->questioned = this->exploded = 0;
+    for (int i = 0; i < CELLS; i++) {
+        switch (this->tiles[i].state) {
+            case TileState::REVEALED:   this->revealedSafe++; break;
+            case TileState::FLAGGED:    this->flagged++;      break;
+            case TileState::QUESTIONED: this->questioned++;   break;
+            case TileState::EXPLODED:   this->exploded++;     break;
+            default: break;
+        }
+    }
+}
+
+template <int R, int C, int M>
+bool operator==(const FixedBoard<R, C, M>& b1, const FixedBoard<R, C, M>& b2) {
+    for (int i = 0; i < FixedBoard<R, C, M>::CELLS; i++) {
+        if (!(b1.tiles[i] == b2.tiles[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // FIXED_BOARD
@@ -0,0 +1,128 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "board.hpp"
+#include "board_pool.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+#ifndef GAME_SERVER
+#define GAME_SERVER
+// Log-bucketed latency histogram: 8 linear sub-buckets per power of two, so
+// a percentile is reported within 12.5% of the true value.  Fixed size, no
+// allocation on record().
+class LatencyHistogram {
+    public:
+        void record(uint64_t ns);
+
+        // @return number of samples recorded
+        uint64_t count() const { return this->samples; }
+
+        // @return largest sample recorded (0 if none)
+        uint64_t max() const { return this->largest; }
+
+        // @return upper bound of the bucket holding the p-th percentile
+        // (0 < p <= 100), or 0 if nothing was recorded
+        uint64_t percentile(double p) const;
+
+        void clear();
+
+    private:
+        array<uint64_t, 512> buckets{};
+        uint64_t samples = 0;
+        uint64_t largest = 0;
+
+        static int bucket(uint64_t ns);
+        static uint64_t upperBound(int bucket);
+};
+
+// Headless game server for bot clients: many independent Boards, addressed
+// by game id, driven by a line-based protocol.  One request per line, one
+// reply line per request, in request order:
+//
+//   NEW <id> <rows> <cols> <mines> [seed]  -> OK <id>
+//   RESET <id> [<rows> <cols> <mines>] [seed]
+//                                          -> OK <id>   (same size by default)
+//   REVEAL|FLAG|CHORD <id> <row> <col>     -> DIFF <id> <status> <n> <change>...
+//   MOVES <id> (R|F|C <row> <col>)...      -> DIFF ... (one Board::apply batch)
+//   SAVE|LOAD <id> <name>                  -> OK <id>   (Board::save/load)
+//   DROP <id>                              -> OK <id>
+//   STATS                                  -> OK stats games=.. requests=.. p50_us=.. p99_us=.. max_us=..
+//   QUIT                                   -> OK bye, then the connection closes
+//   SHUTDOWN                               -> OK bye, then the server stops
+//
+// <status> is play, won or lost.  Each <change> is the row-major tile index
+// followed by C, R<count>, F, Q or X (covered, revealed, flagged, questioned,
+// exploded), e.g. "17R3" - the entries of Board::apply's diff.  Failures
+// reply "ERR <id or -> <reason>".  SAVE/LOAD take a plain file name inside
+// the server's save directory (no '/', not "." or ".."); without a save
+// directory they are refused, so clients cannot reach arbitrary files.
+//
+// The event loop reads whatever requests have arrived (from every client),
+// runs them as one batch and writes each client's replies with one write.
+// A batch is split by game: each game's requests run in order on one worker
+// of the pool, different games in parallel.  Latency is measured per request
+// from the read that delivered it to the write of its reply.  Boards come
+// from a BoardPool, so NEW after DROP reuses a board instead of allocating.
+class GameServer {
+    public:
+        // threads == 0 picks std::thread::hardware_concurrency().  SAVE and
+        // LOAD work on files in `saveDirectory` (empty: disabled).
+        explicit GameServer(size_t threads = 0, const string& saveDirectory = string());
+        ~GameServer();
+
+        GameServer(const GameServer&) = delete;
+        GameServer& operator=(const GameServer&) = delete;
+
+        // Run a batch of request lines (without their newlines); replies[i]
+        // answers lines[i].
+        void handle(const vector<string>& lines, vector<string>& replies);
+
+        // Serve one client on a pair of file descriptors (stdin/stdout) until
+        // end of input, QUIT or SHUTDOWN
+        // @return 0 on success, -1 on an I/O error
+        int serve(int in, int out);
+
+        // Listen on a Unix socket at `path` (replacing a stale one) and serve
+        // any number of clients until one sends SHUTDOWN
+        // @return 0 on success, -1 if the socket cannot be set up
+        int serveSocket(const string& path);
+
+        // @return per-request latency of everything served so far
+        const LatencyHistogram& latency() const;
+
+        // @return number of live games
+        size_t games() const;
+
+    private:
+        struct Game;
+        struct Client;
+
+        BoardPool boards;
+        unordered_map<string, unique_ptr<Game>> table;
+        ThreadPool pool;
+        LatencyHistogram latencies;
+        string saveDirectory;
+
+        // @return false if `name` is not a plain file name; otherwise `path`
+        // is its place in the save directory
+        bool savePath(const string& name, string& path) const;
+
+        // Event loop over `clients` (and `listener` if >= 0)
+        int loop(vector<Client>& clients, int listener);
+
+        // Run one request against its game (on a worker)
+        void run(Game& game, const vector<string>& words, string& reply);
+};
+#endif
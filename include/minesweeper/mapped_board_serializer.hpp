@@ -0,0 +1,63 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <iostream>
+#include <cstdint>
+#include "board.hpp"
+
+#ifndef MAPPEDBOARD_SERIALIZER
+#define MAPPEDBOARD_SERIALIZER
+// Header of the mappable save format.  The file is this header followed by
+// the board's tiles byte-for-byte as they sit in memory, sentinel border
+// included ((rows + 2) x (columns + 2) bytes, see Board), so Board::attach()
+// can mmap the file and use it as its tile storage without copying or parsing
+// the tiles.  Integers are in native byte order; `tileProbe` records how this
+// build packs a Tile so files from an incompatible build are rejected.
+struct MappedBoardHeader {
+    char magic[4];          // "MSWM"
+    uint16_t version;
+    uint8_t tileProbe;      // in-memory byte of a reference Tile
+    uint8_t reserved0;
+    int32_t rows;
+    int32_t columns;
+    int32_t mines;
+    // Game-state counters (informational: load and attach rebuild them from
+    // the tiles, so a stale or edited header cannot lie about the game)
+    int32_t revealedSafe;
+    int32_t flagged;
+    int32_t questioned;
+    int32_t exploded;
+    uint8_t reserved[28];
+};
+static_assert(sizeof(MappedBoardHeader) == 64, "MappedBoardHeader must stay 64 bytes");
+
+// Stream serializer for the mappable format.  Use it like any other
+// ISerializable to write files that Board::attach() can open later; load()
+// is the ordinary copying path for streams that cannot be mapped.
+class MappedBoardSerializer : public ISerializable {
+public:
+    // 2: tiles carry the sentinel border (version 1 files are not read)
+    static const uint16_t VERSION = 2;
+
+    MappedBoardSerializer() = default;
+    ~MappedBoardSerializer() override = default;
+
+    // @return 0 on success, -1 if the stream failed
+    int save(Board& board, std::ostream& out) override;
+
+    // @return 0 on success, -1 on a bad header or truncated tiles
+    int load(Board& board, std::istream& in) override;
+
+    // Check magic, version, tile layout and dimensions, and that `available`
+    // bytes (header included) are enough to hold the tiles.
+    // @return 0 if the header is usable, -1 otherwise
+    static int checkHeader(const MappedBoardHeader& header, size_t available);
+
+    // @return a header describing `board`
+    static MappedBoardHeader makeHeader(const Board& board);
+};
+#endif
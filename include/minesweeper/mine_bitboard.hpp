@@ -0,0 +1,65 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstdint>
+#include <vector>
+#include "tile.hpp"
+
+using namespace std;
+
+#ifndef MINE_BITBOARD
+#define MINE_BITBOARD
+// Bit-plane view of where the mines are: one bit per tile, 64 tiles per word.
+// Adjacent mine counts are computed a word at a time by adding the eight
+// shifted neighbor planes with a bit-sliced (carry-save) counter, so a single
+// pass handles 64 tiles (256 with AVX2) without any per-neighbor bounds checks.
+//
+// Each row is stored with a zero guard word on both sides and the plane has a
+// zero guard row above and below, so the edges of the board need no special
+// cases.
+class MineBitboard {
+    public:
+        MineBitboard() = default;
+
+        // Build the mine plane from a tile array.  Row r starts at
+        // tiles[r * rowStride] and holds `columns` tiles.
+        void load(const Tile* tiles, int rows, int columns, int rowStride);
+
+        // Build the plane for a band of rows cut out of a bigger board, with
+        // the tile rows just above and below the band as a one-row halo (null
+        // at the board's edge).  writeAdjacents() then gives the band's tiles
+        // the same counts as a pass over the whole board would.
+        void load(const Tile* tiles, int rows, int columns, int rowStride,
+                  const Tile* above, const Tile* below);
+
+        // @return true if (row,col) holds a mine
+        bool isMine(int row, int col) const;
+
+        // Write the adjacent mine count of every non-mine tile into `tiles`
+        // (same layout as load()).  Mine tiles are left untouched.
+        // `useSimd` lets tests force the scalar kernel.
+        void writeAdjacents(Tile* tiles, int rowStride, bool useSimd = true) const;
+
+        // @return true if this CPU can run the AVX2 kernel
+        static bool simdAvailable();
+
+    private:
+        int rows = 0;
+        int columns = 0;
+        int words = 0;   // data words per row
+        int stride = 0;  // words per stored row (data + 2 guard words)
+
+        // (rows + 2) * stride words, guard rows/words are always zero
+        vector<uint64_t> bits;
+
+        // @return pointer to the first data word of row (-1 and rows are guard rows)
+        const uint64_t* rowWords(int row) const { return &bits[(row + 1) * stride + 1]; }
+
+        // OR the mine bits of one tile row into the row's words
+        void packRow(const Tile* row, int stored);
+};
+#endif
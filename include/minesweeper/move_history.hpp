@@ -0,0 +1,100 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "tile.hpp"
+
+using namespace std;
+
+#ifndef MOVE_HISTORY
+#define MOVE_HISTORY
+// Bounded undo/redo log of tile changes (Board's undo()/redo()).  Each move is
+// the list of tiles it changed, stored as (tile index, byte before, byte
+// after), so undoing or redoing costs O(tiles the move changed), however big
+// the board.  All moves share one arena of changes that keeps its capacity
+// across clear(), so a warmed-up history records without allocating.
+//
+// A move is recorded between begin() and commit(): the board calls note()
+// before each write to a tile, and commit() reads the final bytes back.  A
+// tile noted twice in one move is fine (undo replays the notes backwards).
+class MoveHistory {
+    public:
+        struct Change {
+            int32_t index;
+            Tile before;
+            Tile after;
+        };
+
+        // Keep at most `depth` moves (undo plus redo); 0 records nothing
+        explicit MoveHistory(size_t depth = 0);
+
+        // Change the depth, dropping the oldest moves that no longer fit
+        void setDepth(size_t depth);
+
+        // @return the maximum number of moves kept
+        size_t depth() const { return this->limit; }
+
+        // @return true if moves are being recorded
+        bool enabled() const { return this->limit > 0; }
+
+        // Start recording a move
+        void begin() { this->pending = this->arena.size(); }
+
+        // Record that tiles[index] is about to change from `before`
+        void note(int index, Tile before) {
+            this->arena.push_back({index, before, before});
+        }
+
+        // Finish the move started by begin().  A move that changed nothing is
+        // dropped; anything else discards the redo moves.
+        void commit(const Tile* tiles);
+
+        // Step back over the last move: [first, first + count) are its
+        // changes, to be undone last to first
+        // @return false if there is nothing to undo
+        bool undo(const Change*& first, size_t& count);
+
+        // Step forward over the next undone move: its changes, to be redone
+        // first to last
+        // @return false if there is nothing to redo
+        bool redo(const Change*& first, size_t& count);
+
+        // @return number of moves that can be undone / redone
+        size_t undoable() const { return this->cursor; }
+        size_t redoable() const { return this->steps.size() - this->cursor; }
+
+        // Forget every move (keeps the arena's capacity)
+        void clear();
+
+    private:
+        // A move's changes: arena[begin, end)
+        struct Step {
+            size_t begin;
+            size_t end;
+        };
+
+        size_t limit;
+
+        // Changes of every kept move, oldest first, starting at arena[base]
+        vector<Change> arena;
+        size_t base = 0;
+
+        // Where the move being recorded started in the arena
+        size_t pending = 0;
+
+        // Kept moves, oldest first; steps[0, cursor) can be undone and
+        // steps[cursor, end) redone
+        vector<Step> steps;
+        size_t cursor = 0;
+
+        // Drop the oldest moves (or, with no undo left, the newest redo
+        // moves) until at most `limit` remain
+        void trim();
+};
+#endif
@@ -0,0 +1,63 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "board.hpp"
+
+using namespace std;
+
+#ifndef MOVE_JOURNAL
+#define MOVE_JOURNAL
+// Append-only autosave: the board is written once as a base snapshot (through
+// the board's own serializer), then every move is appended to a journal file
+// as a 9-byte record.  Saving after a move costs O(1) instead of O(board).
+// Restoring loads the base and replays the journal; once the journal grows
+// past `compactAfter` records the base is rewritten and the journal emptied.
+//
+// Journal file: magic "MSWJ", uint32 version, then records of
+// { uint8 MoveType, int32 row, int32 col } (little-endian).  A partially
+// written last record (crash mid-append) is ignored on replay.
+class MoveJournal {
+    public:
+        static const uint32_t VERSION = 1;
+
+        MoveJournal(const string& basePath, const string& journalPath, size_t compactAfter = 4096);
+
+        // Write `board` as the new base and start an empty journal
+        // @return 0 on success, -1 on I/O failure
+        int begin(Board& board);
+
+        // Append a move that was just applied to `board`.  Compacts when the
+        // journal is full.
+        // @return 0 on success, -1 on I/O failure
+        int record(Board& board, MoveType type, int row, int col);
+
+        // Load the base into `board` and replay the journal on top of it.
+        // Keeps journaling to the same files afterwards.
+        // @return 0 on success, -1 if the base cannot be loaded
+        int restore(Board& board);
+
+        // Rewrite the base from `board` and empty the journal
+        // @return 0 on success, -1 on I/O failure
+        int compact(Board& board);
+
+        // @return number of moves in the journal since the last base
+        size_t length() const;
+
+    private:
+        string basePath;
+        string journalPath;
+        size_t compactAfter;
+        size_t records = 0;
+        ofstream journal;
+
+        // Truncate the journal to just its header and keep it open for appending
+        int openEmptyJournal();
+};
+#endif
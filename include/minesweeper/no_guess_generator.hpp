@@ -0,0 +1,49 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstdint>
+#include <vector>
+#include "board.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+#ifndef NO_GUESS_GENERATOR
+#define NO_GUESS_GENERATOR
+// Generates mine layouts that the Solver clears from a given first click
+// without ever guessing (for competitive mode).
+//
+// Candidate layout number a is drawn from its own generator seeded with
+// (seed, a), with no mine in the 3x3 area around the first click, so that
+// click always opens a cascade.  Candidates are tried in parallel on the
+// pool: workers claim attempt numbers in order from a shared counter, and
+// once one passes, attempts with a higher number stop (including the ones
+// being solved).  The lowest passing number wins, so the same arguments give
+// the same board for any pool size.
+class NoGuessGenerator {
+    public:
+        // pool == nullptr generates on the calling thread
+        explicit NoGuessGenerator(ThreadPool* pool = nullptr);
+
+        // Give up after this many candidate layouts (default 100000)
+        void setMaxAttempts(uint64_t attempts);
+
+        // Find a no-guess layout; load it with Board(rows, columns, mines)
+        // @return 0 on success, -1 if the mines do not fit outside the first
+        //         click's area or no candidate passed within the attempt limit
+        int generate(int rows, int columns, int mineCount, Cell firstClick, uint64_t seed,
+                     vector<Cell>& mines);
+
+        // @return candidate layouts tried by the last generate(), all threads
+        uint64_t attempts() const;
+
+    private:
+        ThreadPool* pool;
+        uint64_t maxAttempts = 100000;
+        uint64_t lastAttempts = 0;
+};
+#endif
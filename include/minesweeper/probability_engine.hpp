@@ -0,0 +1,69 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstddef>
+#include <vector>
+#include "board.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+#ifndef PROBABILITY_ENGINE
+#define PROBABILITY_ENGINE
+// Mine probability of every tile, as computed by ProbabilityEngine
+struct MineProbabilities {
+    int rows = 0;
+    int columns = 0;
+    vector<double> mine;        // row-major; 0 for revealed tiles, 1 for flagged/exploded
+    bool exact = true;          // false if any part fell back to the approximation
+    int components = 0;         // independent frontier components found
+
+    // @return probability that (row,col) holds a mine
+    double at(int row, int col) const { return this->mine[row * this->columns + col]; }
+};
+
+// Exact mine probabilities for the player's view of a board (revealed
+// counts, flags trusted as mines, the total mine count).
+//
+// The covered tiles next to revealed counts (the frontier) are split into
+// independent components: two tiles are in the same component when a chain
+// of shared constraints links them.  Each component is enumerated on its
+// own with a dynamic program over its tiles in BFS order, memoized on the
+// residual counts of the constraints that are still open, which yields the
+// number of layouts per mine count.  The components are then combined with
+// the C(interior, mines left) weights of the unconstrained interior
+// (computed in log space), and a backward pass turns that into per-tile
+// probabilities.  Components run in parallel on the pool.
+//
+// A component whose DP grows past the state limit, or any work left when
+// the time budget runs out, falls back to a local estimate (the mean
+// count/size of its constraints).  Frontiers too large to combine exactly
+// treat the components as independent at a common interior density.
+// `exact` is false whenever either approximation was used.
+class ProbabilityEngine {
+    public:
+        // pool == nullptr computes on the calling thread
+        explicit ProbabilityEngine(ThreadPool* pool = nullptr);
+
+        // Wall-clock budget for the enumeration and combination of one
+        // compute() (default 0.25 s); reading the board is not limited
+        void setTimeBudget(double seconds);
+
+        // Most DP states kept in one step of a component (default 20000)
+        void setStateLimit(size_t states);
+
+        // Fill `out` for `board`
+        // @return 0 on success, -1 if no mine layout fits the view (wrong
+        //         flags); `out` then holds the approximation
+        int compute(Board& board, MineProbabilities& out);
+
+    private:
+        ThreadPool* pool;
+        double timeBudget = 0.25;
+        size_t stateLimit = 20000;
+};
+#endif
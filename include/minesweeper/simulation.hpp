@@ -0,0 +1,136 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+#include "board.hpp"
+#include "probability_engine.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+
+#ifndef SIMULATION
+#define SIMULATION
+// A game-playing policy driven by Simulator.  Every worker thread builds its
+// own instance through a StrategyFactory, so implementations need no locking.
+class Strategy {
+    public:
+        virtual ~Strategy() = default;
+
+        // Called before the first move of each game; `seed` is unique per game
+        virtual void start(Board& board, uint64_t seed) = 0;
+
+        // Choose the next move for `board`
+        // @return false to resign the game
+        virtual bool nextMove(Board& board, Move& move) = 0;
+
+        // Called after each move with the tiles whose state it changed
+        virtual void observe(Board& /*board*/, const vector<Cell>& /*changed*/) {}
+};
+
+using StrategyFactory = function<unique_ptr<Strategy>()>;
+
+// Reveals a uniformly random covered tile every turn (the baseline strategy)
+class RandomStrategy : public Strategy {
+    public:
+        void start(Board& board, uint64_t seed) override;
+        bool nextMove(Board& board, Move& move) override;
+
+    private:
+        std::mt19937_64 rng;
+};
+
+// Plays every tile the Solver proves safe; guesses a random tile it knows
+// nothing about only when no safe tile is left.  Guesses walk a per-game
+// shuffle of the board, so all guesses of a game cost O(tiles) in total.
+class SolverStrategy : public Strategy {
+    public:
+        void start(Board& board, uint64_t seed) override;
+        bool nextMove(Board& board, Move& move) override;
+        void observe(Board& board, const vector<Cell>& changed) override;
+
+    protected:
+        // Choose a tile to reveal when nothing is proven safe
+        // @return false if no covered tile is left
+        virtual bool guess(Board& board, Cell& cell);
+
+        std::mt19937_64 rng;
+        unique_ptr<Solver> solver;
+        Board* bound = nullptr;     // board the solver was built for
+        vector<int> guessOrder;     // tiles in random order; guesses take the next unknown one
+        size_t guessNext = 0;
+};
+
+// SolverStrategy that guesses the covered tile least likely to be a mine
+// (ProbabilityEngine); ties go to the earliest tile of the per-game shuffle.
+class ProbabilityStrategy : public SolverStrategy {
+    protected:
+        bool guess(Board& board, Cell& cell) override;
+
+    private:
+        ProbabilityEngine engine;   // single-threaded: the simulator already is parallel
+        MineProbabilities probabilities;
+};
+
+struct SimulationConfig {
+    int rows = 16;
+    int columns = 30;
+    int mines = 99;
+    uint64_t games = 1000;
+    uint64_t seed = 0;          // game g is played on seed gameSeed(seed, g)
+};
+
+struct SimulationResult {
+    uint64_t games = 0;
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t resigned = 0;      // strategy gave up or hit the move limit
+    double seconds = 0.0;       // wall-clock time of Simulator::run
+    vector<uint64_t> revealHistogram;   // [n] = games that took n reveals
+
+    // @return games per second of wall-clock time
+    double gamesPerSecond() const;
+
+    // @return wins / games (0 when no games were played)
+    double winRate() const;
+
+    // @return smallest reveal count reached by at least fraction q of the games
+    int revealPercentile(double q) const;
+
+    // Fold another worker's tallies into this one (seconds are not added)
+    void merge(const SimulationResult& other);
+};
+
+// Plays SimulationConfig::games headless games across a ThreadPool.  Workers
+// claim games from a shared counter in small batches, each reusing one Board
+// (Board::reset) and one Strategy, and tally into a private result that is
+// merged at the end.  Game g depends only on (config.seed, g), so the totals
+// are the same for any thread count.
+class Simulator {
+    public:
+        Simulator(SimulationConfig config, StrategyFactory factory);
+
+        // Run every game on `pool` and block until they finish
+        SimulationResult run(ThreadPool& pool);
+
+        // Play one game on `board` (already reset) with `strategy`
+        // @return number of reveals made; `outcome` tallies the result
+        static int playGame(Board& board, Strategy& strategy, uint64_t seed,
+                            SimulationResult& outcome);
+
+        // @return the board/strategy seed of game `game`
+        static uint64_t gameSeed(uint64_t seed, uint64_t game);
+
+    private:
+        SimulationConfig config;
+        StrategyFactory factory;
+};
+#endif
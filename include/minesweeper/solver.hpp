@@ -0,0 +1,111 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstdint>
+#include <vector>
+#include "board.hpp"
+
+using namespace std;
+
+#ifndef SOLVER
+#define SOLVER
+// What the solver has proven about a tile
+enum Deduction : uint8_t {
+    DEDUCED_UNKNOWN,
+    DEDUCED_SAFE,
+    DEDUCED_MINE
+};
+
+// Deterministic constraint propagation over a board's frontier.
+//
+// The solver only looks at what a player sees: the counts of REVEALED tiles,
+// FLAGGED tiles (trusted as mines) and EXPLODED tiles.  It never reads
+// Tile::isMine of a covered tile.  Each revealed count is a constraint "the
+// unknown neighbors hold count - known mines"; it applies the single-point
+// rules (all safe / all mines) and the pairwise subset/superset rule between
+// constraints that share neighbors.
+//
+// It is incremental: update() queues only the constraints around tiles that
+// changed, and solve() runs the work list to a fixpoint, so the cost of a
+// move is proportional to the frontier it touched, not the board size.
+class Solver {
+    public:
+        // Bind to `board` and queue every revealed tile
+        explicit Solver(Board& board);
+
+        // Forget all deductions and rescan the board (after reset()/load())
+        void reset();
+
+        // Queue the constraints affected by tiles that changed state, e.g. the
+        // buffer filled by Board::revealTile(row, col, revealed) or a toggle
+        void update(const vector<Cell>& changed);
+        void update(int row, int col);
+
+        // Apply the rules until nothing new can be deduced
+        void solve();
+
+        // @return what has been proven about (row,col)
+        Deduction deduction(int row, int col) const;
+
+        // Pop the next proven-safe tile that is still covered
+        // @return false when there is none (call update()/solve() first)
+        bool nextSafe(Cell& cell);
+
+        // @return every tile proven to be a mine, in deduction order
+        const vector<Cell>& minesFound() const;
+
+    private:
+        Board& board;
+        int rows = 0;
+        int columns = 0;
+
+        vector<uint8_t> deduced;        // Deduction per tile, row-major
+        vector<uint8_t> queued;         // 1 while a tile sits in worklist
+        vector<int> worklist;           // revealed tiles whose constraint may yield something
+        vector<Cell> safeFound;         // proven safe, handed out by nextSafe()
+        size_t safeNext = 0;
+        vector<Cell> mineFound;
+
+        // Unknown neighbors of a revealed tile and the mines still among them
+        struct Constraint {
+            int cells[8];
+            int size = 0;
+            int mines = 0;
+        };
+
+        const Tile& tile(int i) const { return *this->board.getTile(i / this->columns, i % this->columns); }
+
+        // @return true if the player view says tile i holds a mine
+        bool knownMine(const Tile& t, int i) const;
+
+        // @return true if nothing is known about tile i yet
+        bool unknown(const Tile& t, int i) const;
+
+        // Collect the constraint of revealed tile i
+        void gather(int i, Constraint& out) const;
+
+        // Queue revealed tile i (once)
+        void enqueue(const Tile& t, int i);
+        void enqueue(int i) { enqueue(tile(i), i); }
+
+        // Queue every revealed neighbor of tile i
+        void touch(int i);
+
+        void markSafe(int i);
+        void markMine(int i);
+
+        // Apply the rules to constraint i
+        // @return true if anything new was proven
+        bool process(int i);
+
+        // Pair rule: the tiles of `c` outside `other` hold c.mines minus the
+        // [leastShared, mostShared] mines of the shared tiles; mark them when
+        // that forces all safe or all mines
+        // @return true if anything was marked
+        bool settleDifference(const Constraint& c, const Constraint& other, int leastShared, int mostShared);
+};
+#endif
@@ -6,6 +6,8 @@
  *                                  |_|          
  */
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include "board.hpp"
 
 #ifndef TEXTBOARD_SERIALIZER
@@ -17,7 +19,53 @@ public:
     
     int save(Board& board, std::ostream& out) override;
     int load(Board& board, std::istream& in) override;
+
+    // The format itself, for any board type (Board, FixedBoard; see IsBoard)
+    template <class B> static int write(B& board, std::ostream& out);
+    template <class B> static int read(B& board, std::istream& in);
+
 private:
-    TileState intToTileState(int value);
+    static TileState intToTileState(int value);
 };
+
+template <class B>
+int TextBoardSerializer::write(B& board, std::ostream& out) {
+    static_assert(IsBoard<B>::value, "TextBoardSerializer: not a board type");
+    // Save rows, columns, mines
+    out << board.getRows() << " " << board.getColumns() << " " << board.getMines() << "\n";
+    // Save each tile's state
+    for (int r = 0; r < board.getRows(); r++) {
+        for (int c = 0; c < board.getColumns(); c++) {
+            Tile* tile = board.getTile(r, c);
+            out << static_cast<int>(tile->state) << " " << tile->isMine << " " << static_cast<unsigned int>(tile->adjacentMines) << "\n";
+        }
+    }
+    return 0; // success
+}
+
+// Every tile is overwritten, so the board is only cleared (no mines laid)
+template <class B>
+int TextBoardSerializer::read(B& board, std::istream& in) {
+    static_assert(IsBoard<B>::value, "TextBoardSerializer: not a board type");
+    int r, c, m;
+    in >> r >> c >> m;
+    if (!in || !board.fits(r, c, m)) {
+        return -1; // invalid dimensions (or not this board's)
+    }
+    Tile* tile;
+    board.clear(r, c, m);
+    for (int row = 0; row < board.getRows(); row++) {
+        for (int col = 0; col < board.getColumns(); col++) {
+            int stateInt;
+            bool isMine;
+            unsigned int adjacentMines;
+            in >> stateInt >> isMine >> adjacentMines;
+            tile = board.getTile(row, col);
+            tile->state = intToTileState(stateInt);
+            tile->isMine = isMine;
+            tile->adjacentMines = adjacentMines;
+        }
+    }
+    return 0; // success
+}
 #endif
@@ -0,0 +1,57 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#ifndef THREAD_POOL
+#define THREAD_POOL
+// Fixed set of worker threads draining a shared FIFO of tasks.
+class ThreadPool {
+    public:
+        // threads == 0 picks std::thread::hardware_concurrency()
+        explicit ThreadPool(size_t threads = 0);
+
+        // Finishes queued tasks, then joins the workers
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Queue a task to run on some worker
+        void submit(function<void()> task);
+
+        // Block until every submitted task has finished
+        void wait();
+
+        // Run body(0..count-1) on the workers and the calling thread, and
+        // return once all `count` calls are done.  Only this call's work is
+        // waited for, and the caller claims indices too, so it is safe to
+        // call from a task already running on this pool.
+        void parallelFor(size_t count, const function<void(size_t)>& body);
+
+        // @return number of worker threads
+        size_t size() const;
+
+    private:
+        vector<thread> workers;
+        deque<function<void()>> tasks;
+        mutex lock;
+        condition_variable taskReady;
+        condition_variable allDone;
+        size_t running = 0;     // tasks currently executing
+        bool stopping = false;
+
+        void workerLoop();
+};
+#endif
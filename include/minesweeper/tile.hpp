@@ -13,10 +13,14 @@ using namespace std;
 #ifndef TILE
 #define TILE
 // Define the tile structure
+// Packed into a single byte: 3 bits of state, 1 mine bit and 4 bits of
+// adjacent mine count (0-8).  Boards store millions of these contiguously.
 struct Tile {
-    TileState state = TileState::COVERED;
-    bool isMine = false;
-    unsigned int adjacentMines = 0;
+    TileState state : 3;
+    bool isMine : 1;
+    uint8_t adjacentMines : 4;
+
+    Tile() : state(TileState::COVERED), isMine(false), adjacentMines(0) {}
 
     // Overload output operator for Tile for debugging only
     // Shows the tile content regardless of state
@@ -25,4 +29,6 @@ struct Tile {
     // Overload the equality operator for testing purposes
     friend bool operator==(const Tile& t1, const Tile& t2);
 };
+
+static_assert(sizeof(Tile) == 1, "Tile must pack into one byte");
 #endif
\ No newline at end of file
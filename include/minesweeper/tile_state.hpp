@@ -6,12 +6,13 @@
  *                                  |_|          
  */
 #include <iostream>
+#include <cstdint>
 using namespace std;
 
 #ifndef TILE_STATE
 #define TILE_STATE
-// Define the tile states
- enum TileState {
+// Define the tile states (uint8_t so a Tile can pack its state into a few bits)
+enum TileState : uint8_t {
     COVERED,
     REVEALED,
     FLAGGED,
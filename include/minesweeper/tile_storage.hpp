@@ -0,0 +1,95 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "tile.hpp"
+
+using namespace std;
+
+#ifndef TILE_STORAGE
+#define TILE_STORAGE
+// A read/write memory mapping of a whole file (POSIX mmap).
+class MappedFile {
+    public:
+        // Map `path`.  With `shared` the mapping is MAP_SHARED and writes go
+        // straight to the file; otherwise it is a private copy-on-write view
+        // and the file is never modified.
+        // @return the mapping, or null if the file cannot be opened or mapped
+        static shared_ptr<MappedFile> open(const string& path, bool shared);
+
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // @return start of the mapped bytes
+        char* data() const { return this->bytes; }
+
+        // @return number of mapped bytes (the file size)
+        size_t size() const { return this->length; }
+
+        // @return true if writes reach the file
+        bool isShared() const { return this->shared; }
+
+        // Flush dirty pages of a shared mapping to disk
+        // @return 0 on success, -1 on failure
+        int sync();
+
+    private:
+        MappedFile() = default;
+
+        char* bytes = nullptr;
+        size_t length = 0;
+        bool shared = false;
+};
+
+// Contiguous tile array that is either owned (a vector) or borrowed from a
+// MappedFile.  Copying always produces an owned copy, so a copy of an
+// attached board never writes into the file; moving keeps the mapping.
+class TileStorage {
+    public:
+        TileStorage() = default;
+        TileStorage(const TileStorage& other);
+        TileStorage& operator=(const TileStorage& other);
+        TileStorage(TileStorage&&) = default;
+        TileStorage& operator=(TileStorage&&) = default;
+
+        // Replace the contents with `count` copies of `tile`, dropping any mapping
+        void assign(size_t count, const Tile& tile);
+
+        // Make room for `count` owned tiles without changing the contents.
+        // The new capacity is written once, so its pages are already faulted
+        // in when assign() grows into it.  No-op while borrowing a mapping.
+        void reserve(size_t count);
+
+        // Borrow `count` tiles starting `offset` bytes into `file`
+        void attach(shared_ptr<MappedFile> file, size_t offset, size_t count);
+
+        // @return the mapping the tiles live in, or null when owned
+        const shared_ptr<MappedFile>& mapping() const { return this->file; }
+
+        Tile* data() { return this->base; }
+        const Tile* data() const { return this->base; }
+        size_t size() const { return this->count; }
+
+        Tile& operator[](size_t i) { return this->base[i]; }
+        const Tile& operator[](size_t i) const { return this->base[i]; }
+
+        Tile* begin() { return this->base; }
+        Tile* end() { return this->base + this->count; }
+        const Tile* begin() const { return this->base; }
+        const Tile* end() const { return this->base + this->count; }
+
+    private:
+        vector<Tile> owned;
+        shared_ptr<MappedFile> file;
+        Tile* base = nullptr;
+        size_t count = 0;
+};
+#endif
@@ -0,0 +1,197 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ *
+ * minesweeper_bench: timings for the Board hot paths, as JSON on stdout.
+ *
+ * Run:
+ *   ./minesweeper_bench [--max-size N] [--min-time SECONDS] > bench.json
+ *
+ * Square boards from 9x9 up to --max-size (default 8192).  Each benchmark
+ * repeats until --min-time (default 0.2 s) of measured time has accumulated;
+ * per-iteration setup (fresh boards, input streams) is not measured.
+ * Progress goes to stderr.
+ *
+ * "preset_play" plays whole games on the classic presets, once with Board and
+ * once with FixedBoard (same layouts, same moves); items are revealTile calls.
+ *
+ * layMines and calculateAdjacents are private: "calculate_adjacents" runs
+ * the same MineBitboard pass Board uses, and "lay_mines" is derived as
+ * reset - clear - calculate_adjacents at the same size and density.
+ * "reset_banded" is the parallel reset (row bands, one thread per core).
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "minesweeper/board.hpp"
+#include "minesweeper/board_pool.hpp"
+#include "minesweeper/fixed_board.hpp"
+#include "minesweeper/mine_bitboard.hpp"
+#include "minesweeper/no_guess_generator.hpp"
+#include "minesweeper/thread_pool.hpp"
+using namespace std;
+
+struct Result {
+    string name; int rows=0, cols=0, mines=0;
+    uint64_t iterations=0;
+    double ns_mean=0, ns_min=0;     // per iteration
+    double items=1;                 // work items per iteration (tiles, toggles, ...)
+    bool derived=false;
+};
+
+static double min_time=0.2;
+static vector<Result> results;
+
+static double now_ns(){
+    return (double)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Time body() after an untimed setup() until min_time has been measured
+static Result& run(const string& name,int rows,int cols,int mines,double items,
+                   const function<void()>& setup,const function<void()>& body){
+    Result r; r.name=name; r.rows=rows; r.cols=cols; r.mines=mines; r.items=items;
+    double total=0, best=1e300;
+    while(total<min_time*1e9 && r.iterations<100000){
+        setup();
+        double t0=now_ns(); body(); double dt=now_ns()-t0;
+        total+=dt; best=min(best,dt); r.iterations++;
+    }
+    r.ns_mean=total/r.iterations; r.ns_min=best;
+    fprintf(stderr,"%-22s %5dx%-5d %10.0f ns/iter  (%llu iters)\n",name.c_str(),rows,cols,r.ns_mean,(unsigned long long)r.iterations);
+    results.push_back(r);
+    return results.back();
+}
+static void none(){}
+
+static void bench_size(int n){
+    int cells=n*n;
+    const double densities[]={0.01,0.15,0.5,0.9};
+    uint64_t seed=12345;
+
+    run("construct",n,n,(int)(cells*0.15),cells,none,[&]{ Board b(n,n,(int)(cells*0.15),seed); });
+    { BoardPool pool; run("pool_acquire",n,n,(int)(cells*0.15),cells,none,[&]{ auto b=pool.acquire(n,n,(int)(cells*0.15),seed); }); }
+
+    Board board(n,n,0,seed);
+    ThreadPool pool;
+    Result& clr=run("clear",n,n,0,cells,none,[&]{ board.clear(n,n,0); });
+
+    for(double d : densities){
+        int m=(int)(cells*d);
+        Result& rst=run("reset",n,n,m,cells,none,[&]{ board.reset(n,n,m,seed); });
+        run("reset_banded",n,n,m,cells,none,[&]{ board.reset(n,n,m,seed,&pool); });
+        MineBitboard bits;
+        Result& adj=run("calculate_adjacents",n,n,m,cells,none,[&]{
+            int stride=(int)(board.getTile(1%n,0)-board.getTile(0,0));   // rows are padded (0 for n==1 is unused)
+            bits.load(board.getTile(0,0),n,n,stride); bits.writeAdjacents(board.getTile(0,0),stride);
+        });
+        Result lay=rst; lay.name="lay_mines"; lay.items=m; lay.derived=true;
+        lay.ns_mean=max(0.0,rst.ns_mean-clr.ns_mean-adj.ns_mean);
+        lay.ns_min=max(0.0,rst.ns_min-clr.ns_min-adj.ns_min);
+        results.push_back(lay);
+    }
+
+    // Worst-case cascade: no mines, so one click floods every tile
+    run("reveal_cascade",n,n,0,cells,[&]{ board.clear(n,n,0); },[&]{ board.revealTile(0,0); });
+
+    // The same cascade with undo recording on, then stepping it back and forth
+    board.setUndoDepth(16);
+    run("record_cascade",n,n,0,cells,[&]{ board.clear(n,n,0); },[&]{ board.revealTile(0,0); });
+    run("undo_cascade",n,n,0,cells,[&]{ board.clear(n,n,0); board.revealTile(0,0); },[&]{ board.undo(); });
+    run("redo_cascade",n,n,0,cells,[&]{ board.clear(n,n,0); board.revealTile(0,0); board.undo(); },[&]{ board.redo(); });
+    board.setUndoDepth(0);
+
+    board.reset(n,n,(int)(cells*0.15),seed);
+    const int toggles=1<<20;
+    vector<Cell> spots(toggles);
+    std::mt19937_64 rng(seed);
+    for(Cell& c : spots){ c.row=(int)(rng()%n); c.col=(int)(rng()%n); }
+    run("toggle",n,n,board.getMines(),toggles,none,[&]{ for(const Cell& c : spots) board.toggleTile(c.row,c.col); });
+    vector<Move> batch;
+    for(const Cell& c : spots) batch.push_back({MOVE_TOGGLE,c.row,c.col});
+    run("apply_toggles",n,n,board.getMines(),toggles,none,[&]{ board.apply(batch); });
+
+    Board a(n,n,(int)(cells*0.15),seed), b(n,n,(int)(cells*0.15),seed);
+    run("equality",n,n,a.getMines(),cells,none,[&]{ if(!(a==b)) abort(); });
+
+    string text;
+    Result& save=run("text_save",n,n,a.getMines(),cells,none,[&]{ ostringstream out; a.save(out); text=out.str(); });
+    (void)save;
+    istringstream in;
+    run("text_load",n,n,a.getMines(),cells,[&]{ in.str(text); in.clear(); },[&]{ if(board.load(in)!=0) abort(); });
+}
+
+// Random-order reveals until each game ends; both board types see identical
+// games because they lay mines with the same draws from the same seed
+template<class B>
+static void bench_preset(const char* name,B& board){
+    static_assert(IsBoard<B>::value,"bench_preset: not a board type");
+    int R=board.getRows(), C=board.getColumns(), M=board.getMines();
+    const int games=256;
+    vector<int> order(R*C);
+    for(int i=0;i<R*C;++i) order[i]=i;
+    shuffle(order.begin(),order.end(),std::mt19937_64(7));
+    uint64_t calls=0;
+    auto play=[&]{
+        calls=0;
+        for(int g=0;g<games;++g){
+            board.reset(R,C,M);
+            for(size_t k=0;k<order.size() && !board.isLost() && !board.isWon();++k){
+                int r=order[k]/C, c=order[k]%C;
+                if(board.getTile(r,c)->state!=COVERED) continue;
+                board.revealTile(r,c); ++calls;
+            }
+        }
+    };
+    play();   // warm up, and count the calls one iteration makes
+    run(name,R,C,M,(double)calls,none,play);
+}
+
+static void print_json(int max_size){
+    printf("{\n  \"suite\": \"minesweeper_bench\",\n  \"max_size\": %d,\n  \"min_time_s\": %g,\n  \"results\": [\n",max_size,min_time);
+    for(size_t i=0;i<results.size();++i){
+        const Result& r=results[i];
+        printf("    {\"name\": \"%s\", \"rows\": %d, \"cols\": %d, \"mines\": %d, \"iterations\": %llu, "
+               "\"ns_per_iter\": %.1f, \"ns_min\": %.1f, \"items_per_iter\": %.0f, \"ns_per_item\": %.4f, \"derived\": %s}%s\n",
+               r.name.c_str(),r.rows,r.cols,r.mines,(unsigned long long)r.iterations,r.ns_mean,r.ns_min,
+               r.items,r.items>0?r.ns_mean/r.items:0.0,r.derived?"true":"false",i+1<results.size()?",":"");
+    }
+    printf("  ]\n}\n");
+}
+
+int main(int argc,char** argv){
+    int max_size=8192;
+    for(int i=1;i<argc;++i){
+        if(!strcmp(argv[i],"--max-size") && i+1<argc) max_size=atoi(argv[++i]);
+        else if(!strcmp(argv[i],"--min-time") && i+1<argc) min_time=atof(argv[++i]);
+        else { fprintf(stderr,"usage: %s [--max-size N] [--min-time SECONDS]\n",argv[0]); return 2; }
+    }
+
+    for(int n : {9,64,256,1024,4096,8192}) if(n<=max_size) bench_size(n);
+
+    // Classic presets: dynamic Board vs compile-time FixedBoard
+    { Board b(9,9,10,uint64_t(1));   bench_preset("preset_play_board",b); }
+    { BeginnerBoard b(1);            bench_preset("preset_play_fixed",b); }
+    { Board b(16,16,40,uint64_t(1)); bench_preset("preset_play_board",b); }
+    { IntermediateBoard b(1);        bench_preset("preset_play_fixed",b); }
+    { Board b(16,30,99,uint64_t(1)); bench_preset("preset_play_board",b); }
+    { ExpertBoard b(1);              bench_preset("preset_play_fixed",b); }
+
+    // Competitive mode: no-guess expert boards, first click in the middle
+    NoGuessGenerator gen;
+    vector<Cell> mines;
+    uint64_t g=0;
+    run("no_guess_generate",16,30,99,1,none,[&]{ if(gen.generate(16,30,99,{8,15},g++,mines)!=0) abort(); });
+
+    print_json(max_size);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+
+#include <cstring>
+#include <vector>
+#include "minesweeper/binary_board_serializer.hpp"
+#include "minesweeper/board.hpp"
+
+namespace {
+    const char MAGIC[4] = {'M', 'S', 'W', 'B'};
+
+    void putU16(char* p, uint16_t v) {
+        p[0] = static_cast<char>(v & 0xff);
+        p[1] = static_cast<char>(v >> 8);
+    }
+
+    void putU32(char* p, uint32_t v) {
+        for (int i = 0; i < 4; i++) p[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+    }
+
+    uint16_t getU16(const char* p) {
+        return static_cast<uint16_t>(static_cast<uint8_t>(p[0]) | (static_cast<uint8_t>(p[1]) << 8));
+    }
+
+    uint32_t getU32(const char* p) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) v |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+        return v;
+    }
+
+    // 32-bit FNV-1a
+    uint32_t checksum(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+}
+
+int BinaryBoardSerializer::save(Board& board, std::ostream& out) {
+    return write(board, out);
+}
+
+int BinaryBoardSerializer::load(Board& board, std::istream& in) {
+    return read(board, in);
+}
+
+void BinaryBoardSerializer::frame(std::vector<char>& buffer, int rows, int columns, int mines) {
+    size_t cells = static_cast<size_t>(rows) * columns;
+    memcpy(&buffer[0], MAGIC, sizeof(MAGIC));
+    putU16(&buffer[4], VERSION);
+    putU16(&buffer[6], 0);
+    putU32(&buffer[8], static_cast<uint32_t>(rows));
+    putU32(&buffer[12], static_cast<uint32_t>(columns));
+    putU32(&buffer[16], static_cast<uint32_t>(mines));
+    putU32(&buffer[HEADER_SIZE + cells], checksum(&buffer[HEADER_SIZE], cells));
+}
+
+int BinaryBoardSerializer::readPayload(std::istream& in, int& rows, int& columns, int& mines, std::vector<char>& payload) {
+    char header[HEADER_SIZE];
+    if (!in.read(header, HEADER_SIZE)) {
+        return -1; // truncated header
+    }
+    if (memcmp(header, MAGIC, sizeof(MAGIC)) != 0 || getU16(&header[4]) != VERSION) {
+        return -1; // not ours, or a version we do not understand
+    }
+    rows = static_cast<int>(getU32(&header[8]));
+    columns = static_cast<int>(getU32(&header[12]));
+    mines = static_cast<int>(getU32(&header[16]));
+    if (rows <= 0 || columns <= 0 || mines < 0 || static_cast<long long>(rows) * columns > INT32_MAX) {
+        return -1; // invalid dimensions
+    }
+
+    size_t cells = static_cast<size_t>(rows) * columns;
+    payload.resize(cells + 4);
+    if (!in.read(payload.data(), static_cast<std::streamsize>(payload.size()))) {
+        return -1; // truncated tile data
+    }
+    if (checksum(payload.data(), cells) != getU32(&payload[cells])) {
+        return -1; // corrupted
+    }
+    for (size_t i = 0; i < cells; i++) {
+        uint8_t byte = static_cast<uint8_t>(payload[i]);
+        if ((byte & 0x7) > TileState::EXPLODED || (byte >> 4) > 8) {
+            return -1; // impossible tile
+        }
+    }
+    return 0;
+}
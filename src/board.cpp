@@ -5,11 +5,17 @@
  *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
  *                                  |_|          
  */
+#include <algorithm>
 #include <memory>
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <functional>
 #include "minesweeper/board.hpp"
+#include "minesweeper/thread_pool.hpp"
 #include "minesweeper/text_board_serializer.hpp"
+#include "minesweeper/mapped_board_serializer.hpp"
 
 using namespace std;
 
@@ -18,7 +24,7 @@ using namespace std;
 ostream& operator<<(ostream& out, const Board& board) {
     for (int r = 0; r < board.rows; r++) {
         for (int c = 0; c < board.columns; c++) {
-            out << board.tiles[r][c] << " ";
+            out << board.tiles[board.index(r, c)] << " ";
         }
         out << "\n";
     }
@@ -30,28 +36,117 @@ bool operator==(const Board& b1, const Board& b2) {
     if (b1.rows != b2.rows || b1.columns != b2.columns || b1.mines != b2.mines) {
         return false;
     }
-    for (int r = 0; r < b1.rows; r++) {
-        for (int c = 0; c < b1.columns; c++) {
-            if (!(b1.tiles[r][c] == b2.tiles[r][c])) {
-                return false;
-            }
+    // Same size means the same layout, sentinel border included
+    for (size_t i = 0; i < b1.tiles.size(); i++) {
+        if (!(b1.tiles[i] == b2.tiles[i])) {
+            return false;
         }
     }
     return true;
 }
 
+namespace {
+    // Fresh 64-bit seed for boards created without one
+    uint64_t randomSeed() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+
+    // SplitMix64 finalizer: a well-mixed hash of x
+    uint64_t mix64(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Counter-based generator: output i of stream (seed, stream) is a hash of
+    // the key and i, so a band's draws never depend on another band's
+    struct BandRandom {
+        using result_type = uint64_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+
+        BandRandom(uint64_t seed, uint64_t stream) : key(mix64(seed ^ mix64(stream))) {}
+        result_type operator()() { return mix64(this->key + this->counter++); }
+
+        uint64_t key;
+        uint64_t counter = 0;
+    };
+
+    // lgamma() without its write to the global signgam, which races when
+    // boards are generated on several threads at once
+    double logGamma(double x) {
+        int sign;
+        return lgamma_r(x, &sign);
+    }
+
+    // @return how many of `draws` tiles taken without replacement from
+    // `total`, of which `marked` are mines, are mines (hypergeometric).  Walks
+    // the distribution outward from its mode, O(standard deviation).
+    int64_t hypergeometric(int64_t total, int64_t marked, int64_t draws, BandRandom& rng) {
+        int64_t low = max<int64_t>(0, draws - (total - marked));
+        int64_t high = min(draws, marked);
+        if (low == high) {
+            return low;
+        }
+        auto logChoose = [](int64_t n, int64_t k) {
+            return logGamma(n + 1.0) - logGamma(k + 1.0) - logGamma(n - k + 1.0);
+        };
+        // pmf(k + 1) / pmf(k)
+        auto ratio = [&](int64_t k) {
+            return static_cast<double>(marked - k) * static_cast<double>(draws - k)
+                 / (static_cast<double>(k + 1) * static_cast<double>(total - marked - draws + k + 1));
+        };
+        int64_t mode = static_cast<int64_t>((static_cast<double>(draws) + 1) * (static_cast<double>(marked) + 1)
+                                            / (static_cast<double>(total) + 2));
+        mode = min(max(mode, low), high);
+        double pMode = exp(logChoose(marked, mode) + logChoose(total - marked, draws - mode)
+                           - logChoose(total, draws));
+        double u = static_cast<double>(rng() >> 11) * 0x1.0p-53 - pMode;
+        int64_t down = mode, up = mode;
+        double pDown = pMode, pUp = pMode;
+        while (u > 0 && (down > low || up < high)) {
+            if (up < high) {
+                pUp *= ratio(up++);
+                if ((u -= pUp) <= 0) return up;
+            }
+            if (down > low) {
+                pDown /= ratio(--down);
+                if ((u -= pDown) <= 0) return down;
+            }
+        }
+        return mode;    // rounding left a sliver of probability unassigned
+    }
+
+    // Tiles per band of the banded generator (whole rows, at least one)
+    const int BAND_TILES = 1 << 18;
+}
+
 Board::Board() : Board(16, 30, 99, std::make_shared<TextBoardSerializer>()) {}
 
 Board::Board(int rows, int columns, int mines) : 
     Board(rows, columns, mines, std::make_shared<TextBoardSerializer>()) {}
 
 Board::Board(int rows, int columns, int mines, std::shared_ptr<ISerializable> serializer) : 
-    rows(rows), columns(columns), mines(mines), serializer(serializer) {
-    this->tiles.resize(this->rows, vector<Tile>(this->columns));
+    Board(rows, columns, mines, randomSeed(), serializer) {}
+
+Board::Board(int rows, int columns, int mines, uint64_t seed) :
+    Board(rows, columns, mines, seed, std::make_shared<TextBoardSerializer>()) {}
+
+Board::Board(int rows, int columns, int mines, uint64_t seed, std::shared_ptr<ISerializable> serializer) :
+    rng(seed), serializer(serializer) {
+    this->clear(rows, columns, mines);
     this->layMines();
     this->calculateAdjacents();
 }
 
+Board::Board(int rows, int columns, const vector<Cell>& mines) :
+    rows(rows), columns(columns), mines(static_cast<int>(mines.size())), rng(randomSeed()),
+    serializer(std::make_shared<TextBoardSerializer>()) {
+    this->reset(rows, columns, mines);
+}
+
 // Create Board from a stream (file).  This not the same as restoring a game 
 // from a file (see load() method).  This is used to create repeatable starting
 // boards that make testing simpler.
@@ -64,16 +159,18 @@ Board::Board(int rows, int columns, int mines, std::shared_ptr<ISerializable> se
 // . . . * . .
 // . . . . . .
 // . . . . . *
-Board::Board(istream& in) {
-    in >> this->rows >> this->columns >> this->mines;
-    this->tiles.resize(this->rows, vector<Tile>(this->columns));
+Board::Board(istream& in) : rng(randomSeed()), serializer(std::make_shared<TextBoardSerializer>()) {
+    int rows, columns, mines;
+    in >> rows >> columns >> mines;
+    this->clear(rows, columns, mines);
     for (int r = 0; r < this->rows; r++) {
         for (int c = 0; c < this->columns; c++) {
             char ch;
             in >> ch;
-            this->tiles[r][c].state = TileState::COVERED; // redundant but explicit
-            this->tiles[r][c].isMine = (ch == '*') ? true : false;
-            this->tiles[r][c].adjacentMines = 0; // redundant but explicit
+            Tile& tile = this->tiles[index(r, c)];
+            tile.state = TileState::COVERED; // redundant but explicit
+            tile.isMine = (ch == '*') ? true : false;
+            tile.adjacentMines = 0; // redundant but explicit
         }
     }
     this->calculateAdjacents();
@@ -98,120 +195,687 @@ int Board::getMines() const {
 Tile* Board::getTile(int row, int col) {
     // Assert is in bounds
     assert(inBounds(row, col) && "getTile: (row,col) out of bounds");
-    return &tiles[row][col];
+    return &tiles[index(row, col)];
 }
 
 bool Board::revealTile(int row, int col) {
+    this->history.begin();
+    bool boom = reveal(row, col, nullptr);
+    this->history.commit(this->tiles.data());
+    return boom;
+}
+
+bool Board::revealTile(int row, int col, vector<Cell>& revealed) {
+    this->history.begin();
+    bool boom = reveal(row, col, &revealed);
+    this->history.commit(this->tiles.data());
+    return boom;
+}
+
+bool Board::isWon() const {
+    return this->exploded == 0 && this->revealedSafe == this->rows * this->columns - this->mines;
+}
+
+bool Board::isLost() const {
+    return this->exploded > 0;
+}
+
+int Board::minesRemaining() const {
+    return this->mines - this->flagged;
+}
+
+int Board::revealedTiles() const {
+    return this->revealedSafe + this->exploded;
+}
+
+// Reveal (row,col) and, if it has no adjacent mines, flood-fill outward.
+bool Board::reveal(int row, int col, vector<Cell>* revealed) {
     // Assert is in bounds
     assert(inBounds(row, col) && "revealTile: (row,col) out of bounds");
-    
-    Tile& tile = this->tiles[row][col];
-    if (tile.state == TileState::REVEALED || tile.state == TileState::FLAGGED || tile.state == TileState::QUESTIONED) {
+    MS_STATS_TIMER(this->statsData.revealNs);
+    MS_STATS(this->statsData.reveals++; this->statsData.tilesTouched++;
+             this->statsData.maxTilesTouched = max<uint64_t>(this->statsData.maxTilesTouched, 1);)
+
+    Tile& tile = this->tiles[index(row, col)];
+    if (tile.state == TileState::REVEALED || tile.state == TileState::FLAGGED || tile.state == TileState::QUESTIONED ||
+        tile.state == TileState::EXPLODED) {
         return false; // do nothing
     }
+    if (this->firstClick != FIRST_CLICK_ANY && this->revealedSafe == 0 && this->exploded == 0) {
+        protectFirstClick(row, col);
+    }
+    this->floodQueue.clear();
+    bool boom = open(index(row, col), revealed);
+    if (!this->floodQueue.empty()) {
+        flood(revealed);
+    }
+    return boom;
+}
+
+bool Board::chordTile(int row, int col) {
+    this->history.begin();
+    bool boom = chord(row, col, nullptr);
+    this->history.commit(this->tiles.data());
+    return boom;
+}
+
+bool Board::chordTile(int row, int col, vector<Cell>& revealed) {
+    this->history.begin();
+    bool boom = chord(row, col, &revealed);
+    this->history.commit(this->tiles.data());
+    return boom;
+}
+
+// All covered neighbors are opened first and the empty ones seed a single
+// flood fill, so areas that several neighbors lead into are filled once.
+// The sentinel border is REVEALED: it is neither a flag nor opened.
+bool Board::chord(int row, int col, vector<Cell>* revealed) {
+    assert(inBounds(row, col) && "chordTile: (row,col) out of bounds");
+    int i = index(row, col);
+    const Tile& tile = this->tiles[i];
+    if (tile.state != TileState::REVEALED || tile.adjacentMines == 0) {
+        return false; // only numbers chord
+    }
+    int flags = 0;
+    for (int offset : this->neighborOffsets) {
+        flags += this->tiles[i + offset].state == TileState::FLAGGED;
+    }
+    if (flags != tile.adjacentMines) {
+        return false;
+    }
+    this->floodQueue.clear();
+    bool boom = false;
+    for (int offset : this->neighborOffsets) {
+        if (this->tiles[i + offset].state == TileState::COVERED) {
+            boom |= open(i + offset, revealed);
+        }
+    }
+    if (!this->floodQueue.empty()) {
+        flood(revealed);
+    }
+    return boom;
+}
+
+bool Board::open(int i, vector<Cell>* revealed) {
+    Tile& tile = this->tiles[i];
+    note(i);
+    if (revealed) revealed->push_back(cell(i));
     if (tile.isMine) {
         tile.state = TileState::EXPLODED;
+        this->exploded++;
         return true; // mine revealed
     }
-    // Reveal this tile
     tile.state = TileState::REVEALED;
-    // If no adjacent mines, reveal neighbors
+    this->revealedSafe++;
     if (tile.adjacentMines == 0) {
-        for (int dr = -1; dr <= 1; dr++) {
-            for (int dc = -1; dc <= 1; dc++) {
-                if (dr == 0 && dc == 0) continue; // skip self
-                int nr = row + dr;
-                int nc = col + dc;
-                if (inBounds(nr, nc)) {
-                    revealTile(nr, nc);
+        this->floodQueue.push_back(i);
+    }
+    return false;
+}
+
+// The fill uses an explicit queue instead of recursion so large empty areas
+// cannot overflow the stack.  A tile is marked REVEALED before it is queued,
+// so every tile enters the queue at most once and the queue never holds more
+// than rows * columns entries.  Neighbors are the 8 precomputed offsets; the
+// sentinel border is already REVEALED, so no neighbor needs a bounds check.
+void Board::flood(vector<Cell>* revealed) {
+    // Rings: the queue is breadth-first, so a ring ends where the queue ended
+    // when the ring started
+    MS_STATS(int revealedBefore = this->revealedSafe - static_cast<int>(this->floodQueue.size());
+             uint64_t touched = 1, depth = 0; size_t ringEnd = 0;)
+    for (size_t head = 0; head < this->floodQueue.size(); head++) {
+        MS_STATS(if (head == ringEnd) { depth++; ringEnd = this->floodQueue.size(); })
+        int i = this->floodQueue[head];
+        for (int offset : this->neighborOffsets) {
+            int n = i + offset;
+            MS_STATS(touched++;)
+            Tile& neighbor = this->tiles[n];
+            // Only covered tiles spread; a neighbor of an empty tile is never a mine
+            if (neighbor.state != TileState::COVERED || neighbor.isMine) continue;
+            note(n);
+            neighbor.state = TileState::REVEALED;
+            this->revealedSafe++;
+            if (revealed) revealed->push_back(cell(n));
+            if (neighbor.adjacentMines == 0) {
+                this->floodQueue.push_back(n);
+            }
+        }
+    }
+    MS_STATS(
+        BoardStats& st = this->statsData;
+        uint64_t opened = static_cast<uint64_t>(this->revealedSafe - revealedBefore);
+        st.cascades++;
+        st.cascadeTiles += opened;
+        st.maxCascadeTiles = max(st.maxCascadeTiles, opened);
+        st.maxCascadeDepth = max(st.maxCascadeDepth, depth);
+        st.tilesTouched += touched - 1; // the clicked tile was counted on entry
+        st.maxTilesTouched = max(st.maxTilesTouched, touched);
+    )
+}
+
+void Board::setFirstClick(FirstClickPolicy policy) {
+    this->firstClick = policy;
+}
+
+FirstClickPolicy Board::getFirstClick() const {
+    return this->firstClick;
+}
+
+// Move every mine out of the protected area around (row,col).  Targets are
+// drawn by rejection sampling from the board's generator, which takes O(1)
+// expected draws unless nearly every tile is a mine; a scan from a random
+// start bounds the worst case.  If the mines cannot all fit outside the 3x3
+// area, only the clicked tile is protected (and nothing when no tile is free).
+void Board::protectFirstClick(int row, int col) {
+    int cells = this->rows * this->columns;
+    int r0 = row, r1 = row, c0 = col, c1 = col;
+    if (this->firstClick == FIRST_CLICK_OPENING) {
+        r0 = max(0, row - 1);
+        r1 = min(this->rows - 1, row + 1);
+        c0 = max(0, col - 1);
+        c1 = min(this->columns - 1, col + 1);
+        if (cells - (r1 - r0 + 1) * (c1 - c0 + 1) < this->mines) {
+            r0 = r1 = row;
+            c0 = c1 = col;
+        }
+    }
+    if (cells - 1 < this->mines) {
+        return;
+    }
+    auto protectedTile = [&](int i) {
+        int r = i / this->columns;
+        int c = i % this->columns;
+        return r >= r0 && r <= r1 && c >= c0 && c <= c1;
+    };
+    std::uniform_int_distribution<int> pick(0, cells - 1);
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            if (!this->tiles[index(r, c)].isMine) {
+                continue;
+            }
+            int to = -1;
+            for (int tries = 0; tries < 64 && to < 0; tries++) {
+                int i = pick(this->rng);
+                if (!this->tiles[interior(i)].isMine && !protectedTile(i)) {
+                    to = interior(i);
+                }
+            }
+            for (int k = 0, start = pick(this->rng); k < cells && to < 0; k++) {
+                int i = (start + k) % cells;
+                if (!this->tiles[interior(i)].isMine && !protectedTile(i)) {
+                    to = interior(i);
                 }
             }
+            moveMine(index(r, c), to);
+        }
+    }
+}
+
+// Mine tiles carry no count (calculateAdjacents leaves them at 0), so the
+// moved-from tile gets its count computed and the moved-to tile is zeroed;
+// the safe neighbors of each lose or gain one.
+void Board::moveMine(int from, int to) {
+    Tile& source = this->tiles[from];
+    note(from);
+    source.isMine = false;
+    int count = 0;
+    // The border must keep its zero counts, so this walks (row,col) ranges
+    // rather than the neighbor offsets (it runs at most 9 times per game)
+    int fr = from / this->stride - 1;
+    int fc = from % this->stride - 1;
+    for (int r = max(0, fr - 1); r <= min(this->rows - 1, fr + 1); r++) {
+        for (int c = max(0, fc - 1); c <= min(this->columns - 1, fc + 1); c++) {
+            Tile& neighbor = this->tiles[index(r, c)];
+            if (index(r, c) == from) continue;
+            if (neighbor.isMine) {
+                count++;
+            } else {
+                note(index(r, c));
+                neighbor.adjacentMines--;
+            }
+        }
+    }
+    source.adjacentMines = count;
+
+    Tile& target = this->tiles[to];
+    note(to);
+    target.isMine = true;
+    target.adjacentMines = 0;
+    int tr = to / this->stride - 1;
+    int tc = to % this->stride - 1;
+    for (int r = max(0, tr - 1); r <= min(this->rows - 1, tr + 1); r++) {
+        for (int c = max(0, tc - 1); c <= min(this->columns - 1, tc + 1); c++) {
+            Tile& neighbor = this->tiles[index(r, c)];
+            if (index(r, c) != to && !neighbor.isMine) {
+                note(index(r, c));
+                neighbor.adjacentMines++;
+            }
         }
     }
-    return false; // no mine revealed
 }
 
 TileState Board::toggleTile(int row, int col) {
     // Assert is in bounds
     assert(inBounds(row, col) && "toggleTile: (row,col) out of bounds");
+    MS_STATS(this->statsData.toggles++;)
 
-    Tile& tile = this->tiles[row][col];
+    Tile& tile = this->tiles[index(row, col)];
+    this->history.begin();
+    if (tile.state != TileState::REVEALED && tile.state != TileState::EXPLODED) {
+        note(index(row, col));
+    }
     switch (tile.state) {
         case TileState::COVERED:
             tile.state = TileState::FLAGGED;
+            this->flagged++;
             break;
         case TileState::FLAGGED:
             tile.state = TileState::QUESTIONED;
+            this->flagged--;
+            this->questioned++;
             break;
         case TileState::QUESTIONED:
             tile.state = TileState::COVERED;
+            this->questioned--;
             break;
         default:
             // Do nothing for REVEALED or EXPLODED
             // should not happen
             break;
     }
+    this->history.commit(this->tiles.data());
     return tile.state;
 }
 
+const vector<TileChange>& Board::apply(const vector<Move>& moves) {
+    return apply(moves.data(), moves.size());
+}
+
+// While the batch runs, batchDiff holds the padded index and the state each
+// changed tile had before the batch; afterwards the entries are rewritten in
+// place with the final state and row-major index, dropping tiles that ended
+// where they started.  Clearing batchSeen only touches the changed tiles.
+const vector<TileChange>& Board::apply(const Move* moves, size_t count) {
+    this->batchDiff.clear();
+    this->batchSeen.resize((this->tiles.size() + 63) / 64, 0);
+    this->batching = true;
+    for (size_t m = 0; m < count; m++) {
+        const Move& move = moves[m];
+        switch (move.type) {
+            case MOVE_REVEAL: revealTile(move.row, move.col); break;
+            case MOVE_TOGGLE: toggleTile(move.row, move.col); break;
+            case MOVE_CHORD:  chordTile(move.row, move.col);  break;
+        }
+    }
+    this->batching = false;
+
+    size_t kept = 0;
+    for (const TileChange& change : this->batchDiff) {
+        int i = change.index;
+        this->batchSeen[i >> 6] &= ~(uint64_t{1} << (i & 63));
+        const Tile& tile = this->tiles[i];
+        if (tile.state == change.state) {
+            continue; // back where it started (or only its count moved)
+        }
+        Cell at = cell(i);
+        uint8_t adjacent = tile.state == TileState::REVEALED ? tile.adjacentMines : 0;
+        this->batchDiff[kept++] = {at.row * this->columns + at.col, tile.state, adjacent};
+    }
+    this->batchDiff.resize(kept);
+    return this->batchDiff;
+}
+
+void Board::setUndoDepth(size_t depth) {
+    this->history.setDepth(depth);
+}
+
+size_t Board::getUndoDepth() const {
+    return this->history.depth();
+}
+
+bool Board::undo() {
+    const MoveHistory::Change* first;
+    size_t count;
+    if (!this->history.undo(first, count)) {
+        return false;
+    }
+    replay(first, count, false, nullptr);
+    return true;
+}
+
+bool Board::undo(vector<Cell>& changed) {
+    const MoveHistory::Change* first;
+    size_t count;
+    if (!this->history.undo(first, count)) {
+        return false;
+    }
+    replay(first, count, false, &changed);
+    return true;
+}
+
+bool Board::redo() {
+    const MoveHistory::Change* first;
+    size_t count;
+    if (!this->history.redo(first, count)) {
+        return false;
+    }
+    replay(first, count, true, nullptr);
+    return true;
+}
+
+bool Board::redo(vector<Cell>& changed) {
+    const MoveHistory::Change* first;
+    size_t count;
+    if (!this->history.redo(first, count)) {
+        return false;
+    }
+    replay(first, count, true, &changed);
+    return true;
+}
+
+size_t Board::undoable() const {
+    return this->history.undoable();
+}
+
+size_t Board::redoable() const {
+    return this->history.redoable();
+}
+
+// A tile noted more than once in a move (a first reveal's count updates)
+// ends up right either way: undo walks the notes backwards, so the earliest
+// `before` lands last; redo writes each tile's final byte.
+void Board::replay(const MoveHistory::Change* first, size_t count, bool forward, vector<Cell>* changed) {
+    for (size_t k = 0; k < count; k++) {
+        const MoveHistory::Change& change = forward ? first[k] : first[count - 1 - k];
+        Tile& tile = this->tiles[change.index];
+        tally(tile.state, -1);
+        tile = forward ? change.after : change.before;
+        tally(tile.state, 1);
+        if (changed) changed->push_back(cell(change.index));
+    }
+}
+
+void Board::tally(TileState state, int delta) {
+    switch (state) {
+        case TileState::REVEALED:   this->revealedSafe += delta; break;
+        case TileState::FLAGGED:    this->flagged += delta;      break;
+        case TileState::QUESTIONED: this->questioned += delta;   break;
+        case TileState::EXPLODED:   this->exploded += delta;     break;
+        default: break;
+    }
+}
+
 bool Board::inBounds(int row, int col) const {
     return (row >= 0 && row < this->rows && col >= 0 && col < this->columns);
 }
 
 void Board::reset(int rows, int cols, int mines) {
+    this->clear(rows, cols, mines);
+    this->layMines();
+    this->calculateAdjacents();
+}
+
+void Board::clear(int rows, int cols, int mines) {
+    this->shape(rows, cols, mines);
+    this->tiles.assign(static_cast<size_t>(this->rows + 2) * this->stride, Tile());
+    // Sentinel border: the top and bottom rows, and the tiles either side of
+    // every row (the right one of a row sits next to the left one of the next)
+    Tile sentinel;
+    sentinel.state = TileState::REVEALED;
+    Tile* t = this->tiles.data();
+    fill(t, t + this->stride, sentinel);
+    fill(t + index(this->rows, -1), t + this->tiles.size(), sentinel);
+    for (int r = 0; r < this->rows; r++) {
+        t[index(r, -1)] = sentinel;
+        t[index(r, this->columns)] = sentinel;
+    }
+    this->revealedSafe = this->flagged = this->questioned = this->exploded = 0;
+    this->history.clear();
+}
+
+void Board::shape(int rows, int cols, int mines) {
     this->rows = rows;
     this->columns = cols;
     this->mines = mines;
-    this->tiles.clear();
-    this->tiles.resize(this->rows, vector<Tile>(this->columns));
-    this->layMines();
+    this->stride = cols + 2;
+    this->columnsReciprocal = cols > 0 ? ((uint64_t{1} << 32) + cols - 1) / cols : 0;
+    int s = this->stride;
+    this->neighborOffsets = {-s - 1, -s, -s + 1, -1, 1, s - 1, s, s + 1};
+}
+
+bool Board::bordered(const Tile* tiles, int rows, int columns) {
+    auto sentinel = [](const Tile& tile) {
+        return tile.state == TileState::REVEALED && !tile.isMine && tile.adjacentMines == 0;
+    };
+    size_t stride = static_cast<size_t>(columns) + 2;
+    const Tile* bottom = tiles + (static_cast<size_t>(rows) + 1) * stride;
+    for (size_t c = 0; c < stride; c++) {
+        if (!sentinel(tiles[c]) || !sentinel(bottom[c])) return false;
+    }
+    // The right sentinel of a row and the left one of the next are adjacent
+    for (size_t r = 1; r <= static_cast<size_t>(rows); r++) {
+        if (!sentinel(tiles[r * stride]) || !sentinel(tiles[r * stride + stride - 1])) return false;
+    }
+    return true;
+}
+
+void Board::reserve(int rows, int cols) {
+    this->tiles.reserve((static_cast<size_t>(rows) + 2) * (static_cast<size_t>(cols) + 2));
+    this->floodQueue.reserve(static_cast<size_t>(rows) * static_cast<size_t>(cols));
+}
+
+bool Board::fits(int rows, int cols, int mines) {
+    // The bordered grid, (rows + 2) x (cols + 2), must be indexable by int
+    return rows > 0 && cols > 0 && mines >= 0
+        && (static_cast<long long>(rows) + 2) * (static_cast<long long>(cols) + 2) <= INT32_MAX
+        && mines <= rows * cols;
+}
+
+void Board::reset(int rows, int cols, int mines, uint64_t seed) {
+    this->rng.seed(seed);
+    this->reset(rows, cols, mines);
+}
+
+void Board::reset(int rows, int cols, int mines, uint64_t seed, ThreadPool* pool) {
+    this->rng.seed(seed);
+    this->clear(rows, cols, mines);
+    this->generateBands(seed, pool);
+}
+
+void Board::reset(int rows, int cols, const vector<Cell>& mines) {
+    this->clear(rows, cols, static_cast<int>(mines.size()));
+    for (const Cell& cell : mines) {
+        assert(inBounds(cell.row, cell.col) && "reset: mine out of bounds");
+        Tile& tile = this->tiles[index(cell.row, cell.col)];
+        assert(!tile.isMine && "reset: duplicate mine");
+        tile.isMine = true;
+    }
     this->calculateAdjacents();
 }
 
-// Randomly place mines and calculate adjacent mine counts
+// Randomly place exactly `mines` mines using Floyd's sampling algorithm:
+// for each j in [cells - mines, cells) pick t uniformly in [0, j]; if t is
+// already a mine take j instead.  Every subset of `mines` tiles is equally
+// likely, and it takes O(mines) draws no matter how dense the board is.
 void Board::layMines() {
-    // Randomly place mines and calculate adjacent mine counts
-    srand(time(NULL));
-    int placed = 0;
-    while (placed < mines) {
-        int r = rand() % this->rows;
-        int c = rand() % this->columns;
-        if (!this->tiles[r][c].isMine) {
-            this->tiles[r][c].isMine = true;
-            placed++;
+    assert(this->mines >= 0 && this->mines <= this->rows * this->columns && "layMines: too many mines");
+    int cells = this->rows * this->columns;
+    for (int j = cells - this->mines; j < cells; j++) {
+        std::uniform_int_distribution<int> pick(0, j);
+        Tile& tile = this->tiles[interior(pick(this->rng))];
+        if (tile.isMine) {
+            this->tiles[interior(j)].isMine = true;
+        } else {
+            tile.isMine = true;
         }
     }
 }
 
 // Calculate adjacent mine counts for all tiles
+// Counting runs on the mine bit-planes (see MineBitboard), 64 tiles per word.
 void Board::calculateAdjacents() {
-    for (int r = 0; r < this->rows; r++) {
-        for (int c = 0; c < this->columns; c++) {
-            // Skip mines
-            if (this->tiles[r][c].isMine) continue;
-
-            unsigned int count = 0;
-            // Check all neighbors
-            for (int dr = -1; dr <= 1; dr++) {
-                for (int dc = -1; dc <= 1; dc++) {
-                    if (dr == 0 && dc == 0) continue; // skip self
-                    int nr = r + dr;
-                    int nc = c + dc;
-                    if (inBounds(nr, nc) && this->tiles[nr][nc].isMine) {
-                        count++;
-                    }
-                }
+    MS_STATS_TIMER(this->statsData.adjacentsNs);
+    Tile* first = &this->tiles[index(0, 0)];
+    this->mineBits.load(first, this->rows, this->columns, this->stride);
+    this->mineBits.writeAdjacents(first, this->stride);
+}
+
+// Four passes.  The per-band mine counts are split off one band at a time
+// (hypergeometric, so every layout stays equally likely), which is cheap and
+// sequential.  Then each band lays its mines with Floyd's sampling.  Once
+// every band is done, each packs its mine bit-planes with the halo rows of
+// the bands above and below, and only after all of them have packed does any
+// band write its adjacent counts: a halo row is never read while its own
+// band is writing it.  Each pass waits for its own bands only.
+void Board::generateBands(uint64_t seed, ThreadPool* pool) {
+    int bandRows = max(1, BAND_TILES / this->columns);
+    int bands = (this->rows + bandRows - 1) / bandRows;
+    vector<int> bandMines(bands);
+    int64_t cellsLeft = static_cast<int64_t>(this->rows) * this->columns;
+    int64_t minesLeft = this->mines;
+    for (int b = 0; b < bands; b++) {
+        int64_t cells = static_cast<int64_t>(min(bandRows, this->rows - b * bandRows)) * this->columns;
+        BandRandom random(seed, 2 * static_cast<uint64_t>(b));
+        bandMines[b] = static_cast<int>(hypergeometric(cellsLeft, minesLeft, cells, random));
+        cellsLeft -= cells;
+        minesLeft -= bandMines[b];
+    }
+
+    if (bands == 1) {
+        pool = nullptr;     // not worth a hand-off
+    }
+    auto forEachBand = [&](const function<void(size_t)>& body) {
+        if (pool) {
+            pool->parallelFor(static_cast<size_t>(bands), body);
+        } else {
+            for (int b = 0; b < bands; b++) body(static_cast<size_t>(b));
+        }
+    };
+    auto firstRow = [bandRows](size_t b) { return static_cast<int>(b) * bandRows; };
+    auto rowCount = [this, bandRows](size_t b) { return min(bandRows, this->rows - static_cast<int>(b) * bandRows); };
+
+    forEachBand([&](size_t b) {
+        BandRandom random(seed, 2 * static_cast<uint64_t>(b) + 1);
+        int start = firstRow(b) * this->columns;
+        int cells = rowCount(b) * this->columns;
+        for (int j = cells - bandMines[b]; j < cells; j++) {
+            std::uniform_int_distribution<int> pick(0, j);
+            Tile& tile = this->tiles[interior(start + pick(random))];
+            if (tile.isMine) {
+                this->tiles[interior(start + j)].isMine = true;
+            } else {
+                tile.isMine = true;
             }
-            this->tiles[r][c].adjacentMines = count;
         }
-    }
+    });
+
+    MS_STATS_TIMER(this->statsData.adjacentsNs);
+    vector<MineBitboard> planes(bands);
+    forEachBand([&](size_t b) {
+        // The border rows above row 0 and below the last row hold no mines,
+        // so every band can take its halo from the rows next to it
+        const Tile* top = &this->tiles[index(firstRow(b), 0)];
+        int count = rowCount(b);
+        planes[b].load(top, count, this->columns, this->stride, top - this->stride, top + count * this->stride);
+    });
+    forEachBand([&](size_t b) {
+        planes[b].writeAdjacents(&this->tiles[index(firstRow(b), 0)], this->stride);
+    });
 }
 
 int Board::save(ostream& out) {
+#ifdef MS_ENABLE_STATS
+    streampos start = out.tellp();
+    int result;
+    {
+        StatsTimer timer(this->statsData.saveNs);
+        result = serializer->save(*this, out);
+    }
+    streampos end = out.tellp();
+    this->statsData.saves++;
+    if (start != streampos(-1) && end != streampos(-1)) {
+        this->statsData.bytesSaved += static_cast<uint64_t>(end - start);
+    }
+    return result;
+#else
     return serializer->save(*this, out);
+#endif
 }
 
+// Serializers write tiles directly, so the counters are rebuilt afterwards
 int Board::load(istream& in) {
-    return serializer->load(*this, in);
+#ifdef MS_ENABLE_STATS
+    StatsTimer timer(this->statsData.loadNs);
+    streampos start = in.tellg();
+#endif
+    int result = serializer->load(*this, in);
+    this->recount();
+#ifdef MS_ENABLE_STATS
+    streampos end = in.tellg();
+    this->statsData.loads++;
+    if (start != streampos(-1) && end != streampos(-1)) {
+        this->statsData.bytesLoaded += static_cast<uint64_t>(end - start);
+    }
+#endif
+    return result;
+}
+
+int Board::attach(const string& path, bool inPlace) {
+    shared_ptr<MappedFile> file = MappedFile::open(path, inPlace);
+    if (!file || file->size() < sizeof(MappedBoardHeader)) {
+        return -1;
+    }
+    MappedBoardHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (MappedBoardSerializer::checkHeader(header, file->size()) != 0) {
+        return -1;
+    }
+    const Tile* stored = reinterpret_cast<const Tile*>(file->data() + sizeof(MappedBoardHeader));
+    if (!bordered(stored, header.rows, header.columns)) {
+        return -1; // a damaged border would let the flood fill run off the tiles
+    }
+    this->shape(header.rows, header.columns, header.mines);
+    this->tiles.attach(file, sizeof(MappedBoardHeader), static_cast<size_t>(this->rows + 2) * this->stride);
+    this->recount();    // the header's counters may be stale or edited
+    this->history.clear();
+    return 0;
+}
+
+int Board::sync() {
+    const shared_ptr<MappedFile>& file = this->tiles.mapping();
+    if (!file || !file->isShared()) {
+        return 0;
+    }
+    MappedBoardHeader header = MappedBoardSerializer::makeHeader(*this);
+    memcpy(file->data(), &header, sizeof(header));
+    return file->sync();
+}
+
+bool Board::isAttached() const {
+    return this->tiles.mapping() != nullptr;
+}
+
+BoardStats Board::stats() const {
+#ifdef MS_ENABLE_STATS
+    BoardStats snapshot = this->statsData;
+    snapshot.enabled = true;
+    return snapshot;
+#else
+    return BoardStats();
+#endif
+}
+
+void Board::resetStats() {
+    MS_STATS(this->statsData = BoardStats();)
+}
+
+void Board::recount() {
+    this->revealedSafe = this->flagged = this->questioned = this->exploded = 0;
+    for (int r = 0; r < this->rows; r++) {
+        const Tile* line = &this->tiles[index(r, 0)];
+        for (int c = 0; c < this->columns; c++) {
+            tally(line[c].state, 1);
+        }
+    }
 }
 
@@ -0,0 +1,80 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <random>
+#include "minesweeper/board_pool.hpp"
+
+using namespace std;
+
+namespace {
+    uint64_t randomSeed() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+}
+
+int BoardPool::sizeClass(int rows, int columns) {
+    uint64_t cells = static_cast<uint64_t>(rows) * static_cast<uint64_t>(columns);
+    int k = 0;
+    while ((uint64_t{1} << k) < cells) k++;
+    return k;
+}
+
+Board* BoardPool::take(int sizeClass, int rows, int columns) {
+    Board* board;
+    {
+        lock_guard<mutex> guard(this->lock);
+        vector<Board*>& idle = this->idleBoards[sizeClass];
+        if (idle.empty()) {
+            this->arena.emplace_back(1, 1, 0, uint64_t{0});
+            board = &this->arena.back();
+        } else {
+            board = idle.back();
+            idle.pop_back();
+        }
+    }
+    board->reserve(rows, columns);
+    return board;
+}
+
+BoardPool::Handle BoardPool::acquire(int rows, int columns, int mines, uint64_t seed) {
+    int k = sizeClass(rows, columns);
+    Board* board = this->take(k, rows, columns);
+    board->setFirstClick(FIRST_CLICK_ANY);
+    board->setUndoDepth(0);
+    board->reset(rows, columns, mines, seed);
+    return Handle(board, Release{this});
+}
+
+BoardPool::Handle BoardPool::acquire(int rows, int columns, int mines) {
+    return this->acquire(rows, columns, mines, randomSeed());
+}
+
+void BoardPool::reserve(int rows, int columns, size_t count) {
+    vector<Handle> warm;
+    for (size_t i = 0; i < count; i++) {
+        warm.push_back(this->acquire(rows, columns, 0, uint64_t{0}));
+    }
+}   // the handles put the boards (idle ones first, then new) on the free list
+
+void BoardPool::Release::operator()(Board* board) const {
+    int k = sizeClass(board->getRows(), board->getColumns());
+    lock_guard<mutex> guard(this->pool->lock);
+    this->pool->idleBoards[k].push_back(board);
+}
+
+size_t BoardPool::size() const {
+    lock_guard<mutex> guard(this->lock);
+    return this->arena.size();
+}
+
+size_t BoardPool::idle() const {
+    lock_guard<mutex> guard(this->lock);
+    size_t count = 0;
+    for (const vector<Board*>& idle : this->idleBoards) count += idle.size();
+    return count;
+}
@@ -0,0 +1,201 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cassert>
+#include <cmath>
+#include "minesweeper/chunked_board.hpp"
+
+using namespace std;
+
+namespace {
+    // SplitMix64 finalizer: a cheap, well-mixed 64-bit hash
+    uint64_t mix64(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+}
+
+ChunkedBoard::ChunkedBoard(int rows, int columns, double density, uint64_t seed) :
+    rows(rows), columns(columns), seed(seed) {
+    assert(rows > 0 && columns > 0 && "ChunkedBoard: empty board");
+    density = min(max(density, 0.0), 1.0);
+    // 2^64 * density, saturating at "every hash is below"
+    this->mineThreshold = density >= 1.0 ? UINT64_MAX
+                                         : static_cast<uint64_t>(ldexp(density, 64));
+}
+
+int ChunkedBoard::getRows() const {
+    return this->rows;
+}
+
+int ChunkedBoard::getColumns() const {
+    return this->columns;
+}
+
+bool ChunkedBoard::inBounds(int row, int col) const {
+    return (row >= 0 && row < this->rows && col >= 0 && col < this->columns);
+}
+
+bool ChunkedBoard::isLost() const {
+    return this->exploded > 0;
+}
+
+long long ChunkedBoard::getRevealedCount() const {
+    return this->revealedSafe;
+}
+
+size_t ChunkedBoard::chunkCount() const {
+    return this->chunks.size();
+}
+
+uint64_t ChunkedBoard::chunkKey(int chunkRow, int chunkCol) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(chunkRow)) << 32) | static_cast<uint32_t>(chunkCol);
+}
+
+bool ChunkedBoard::mineAt(int row, int col) const {
+    uint64_t chunk = mix64(this->seed ^ mix64(chunkKey(row / CHUNK_SIZE, col / CHUNK_SIZE)));
+    uint64_t local = static_cast<uint64_t>((row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE);
+    return mix64(chunk + local) < this->mineThreshold;
+}
+
+void ChunkedBoard::generate(Chunk& chunk, int chunkRow, int chunkCol) const {
+    // Mine bits for the chunk plus a one-tile halo borrowed from its neighbors
+    const int H = CHUNK_SIZE + 2;
+    array<uint8_t, H * H> mine{};
+    int top = chunkRow * CHUNK_SIZE - 1, left = chunkCol * CHUNK_SIZE - 1;
+    for (int r = 0; r < H; r++) {
+        for (int c = 0; c < H; c++) {
+            if (inBounds(top + r, left + c)) mine[r * H + c] = mineAt(top + r, left + c);
+        }
+    }
+    for (int r = 0; r < CHUNK_SIZE; r++) {
+        for (int c = 0; c < CHUNK_SIZE; c++) {
+            Tile& tile = chunk.tiles[r * CHUNK_SIZE + c];
+            tile = Tile();
+            const uint8_t* m = &mine[(r + 1) * H + (c + 1)];
+            tile.isMine = *m;
+            if (!tile.isMine) {
+                tile.adjacentMines = m[-H - 1] + m[-H] + m[-H + 1] + m[-1] + m[1] + m[H - 1] + m[H] + m[H + 1];
+            }
+        }
+    }
+}
+
+ChunkedBoard::Chunk& ChunkedBoard::chunkFor(int row, int col) {
+    int chunkRow = row / CHUNK_SIZE, chunkCol = col / CHUNK_SIZE;
+    unique_ptr<Chunk>& slot = this->chunks[chunkKey(chunkRow, chunkCol)];
+    if (!slot) {
+        slot.reset(new Chunk());
+        generate(*slot, chunkRow, chunkCol);
+    }
+    return *slot;
+}
+
+Tile* ChunkedBoard::getTile(int row, int col) {
+    assert(inBounds(row, col) && "getTile: (row,col) out of bounds");
+    Chunk& chunk = chunkFor(row, col);
+    return &chunk.tiles[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE];
+}
+
+bool ChunkedBoard::revealTile(int row, int col) {
+    return reveal(row, col, nullptr);
+}
+
+bool ChunkedBoard::revealTile(int row, int col, vector<Cell>& revealed) {
+    return reveal(row, col, &revealed);
+}
+
+// Same breadth-first fill as Board::reveal; chunks are created as the fill
+// reaches them and marked dirty when their tiles change.
+bool ChunkedBoard::reveal(int row, int col, vector<Cell>* revealed) {
+    assert(inBounds(row, col) && "revealTile: (row,col) out of bounds");
+
+    Chunk& chunk = chunkFor(row, col);
+    Tile& tile = chunk.tiles[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE];
+    if (tile.state == TileState::REVEALED || tile.state == TileState::FLAGGED || tile.state == TileState::QUESTIONED ||
+        tile.state == TileState::EXPLODED) {
+        return false; // do nothing
+    }
+    chunk.dirty = true;
+    if (tile.isMine) {
+        tile.state = TileState::EXPLODED;
+        this->exploded++;
+        if (revealed) revealed->push_back({row, col});
+        return true; // mine revealed
+    }
+    tile.state = TileState::REVEALED;
+    this->revealedSafe++;
+    if (revealed) revealed->push_back({row, col});
+    if (tile.adjacentMines != 0) {
+        return false;
+    }
+
+    this->floodQueue.clear();
+    this->floodQueue.push_back({row, col});
+    for (size_t head = 0; head < this->floodQueue.size(); head++) {
+        Cell cell = this->floodQueue[head];
+        for (int dr = -1; dr <= 1; dr++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                if (dr == 0 && dc == 0) continue; // skip self
+                int nr = cell.row + dr;
+                int nc = cell.col + dc;
+                if (!inBounds(nr, nc)) continue;
+                Chunk& owner = chunkFor(nr, nc);
+                Tile& neighbor = owner.tiles[(nr % CHUNK_SIZE) * CHUNK_SIZE + nc % CHUNK_SIZE];
+                if (neighbor.state != TileState::COVERED || neighbor.isMine) continue;
+                neighbor.state = TileState::REVEALED;
+                owner.dirty = true;
+                this->revealedSafe++;
+                if (revealed) revealed->push_back({nr, nc});
+                if (neighbor.adjacentMines == 0) {
+                    this->floodQueue.push_back({nr, nc});
+                }
+            }
+        }
+    }
+    return false; // no mine revealed
+}
+
+TileState ChunkedBoard::toggleTile(int row, int col) {
+    assert(inBounds(row, col) && "toggleTile: (row,col) out of bounds");
+
+    Chunk& chunk = chunkFor(row, col);
+    Tile& tile = chunk.tiles[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE];
+    switch (tile.state) {
+        case TileState::COVERED:
+            tile.state = TileState::FLAGGED;
+            chunk.dirty = true;
+            break;
+        case TileState::FLAGGED:
+            tile.state = TileState::QUESTIONED;
+            chunk.dirty = true;
+            break;
+        case TileState::QUESTIONED:
+            tile.state = TileState::COVERED;
+            chunk.dirty = true;
+            break;
+        default:
+            // Do nothing for REVEALED or EXPLODED
+            break;
+    }
+    return tile.state;
+}
+
+size_t ChunkedBoard::evictClean() {
+    size_t evicted = 0;
+    for (auto it = this->chunks.begin(); it != this->chunks.end(); ) {
+        if (!it->second->dirty) {
+            it = this->chunks.erase(it);
+            evicted++;
+        } else {
+            ++it;
+        }
+    }
+    return evicted;
+}
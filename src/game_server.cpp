@@ -0,0 +1,463 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "minesweeper/game_server.hpp"
+
+using namespace std;
+
+namespace {
+    using Clock = chrono::steady_clock;
+
+    // @return true if `word` is a whole base-10 integer
+    template <class T>
+    bool parse(const string& word, T& value) {
+        const char* end = word.data() + word.size();
+        auto result = from_chars(word.data(), end, value);
+        return result.ec == errc() && result.ptr == end && !word.empty();
+    }
+
+    void split(const string& line, vector<string>& words) {
+        words.clear();
+        size_t at = 0;
+        while (at < line.size()) {
+            size_t start = line.find_first_not_of(" \t\r", at);
+            if (start == string::npos) break;
+            size_t end = line.find_first_of(" \t\r", start);
+            if (end == string::npos) end = line.size();
+            words.emplace_back(line, start, end - start);
+            at = end;
+        }
+        if (!words.empty()) {
+            for (char& ch : words[0]) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
+        }
+    }
+
+    bool isGameCommand(const string& command) {
+        static const char* const commands[] = {
+            "NEW", "RESET", "REVEAL", "FLAG", "CHORD", "MOVES", "SAVE", "LOAD", "DROP"
+        };
+        for (const char* known : commands) {
+            if (command == known) return true;
+        }
+        return false;
+    }
+
+    const char* statusOf(const Board& board) {
+        return board.isLost() ? "lost" : board.isWon() ? "won" : "play";
+    }
+
+    // Write all of `bytes`, retrying short writes
+    int writeAll(int fd, const string& bytes) {
+        size_t done = 0;
+        while (done < bytes.size()) {
+            ssize_t n = write(fd, bytes.data() + done, bytes.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return -1;
+            done += static_cast<size_t>(n);
+        }
+        return 0;
+    }
+}
+
+// ---------- LatencyHistogram ----------
+
+// Samples below 8 ns get a bucket each; above that, bucket 8e + s covers
+// the s-th eighth of [2^(e+2), 2^(e+3)).
+int LatencyHistogram::bucket(uint64_t ns) {
+    if (ns < 8) {
+        return static_cast<int>(ns);
+    }
+    int exponent = 63;
+    while (!(ns >> exponent)) exponent--;
+    int sub = static_cast<int>((ns >> (exponent - 3)) & 7);
+    return (exponent - 2) * 8 + sub;
+}
+
+uint64_t LatencyHistogram::upperBound(int bucket) {
+    if (bucket < 8) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int exponent = bucket / 8 + 2;
+    uint64_t sub = static_cast<uint64_t>(bucket % 8);
+    uint64_t width = uint64_t{1} << (exponent - 3);
+    return (8 + sub) * width + width - 1;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    this->buckets[bucket(ns)]++;
+    this->samples++;
+    this->largest = std::max(this->largest, ns);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (this->samples == 0) {
+        return 0;
+    }
+    // Rank of the sample at the p-th percentile (1-based, rounded up)
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(this->samples) + 0.999999);
+    rank = std::max<uint64_t>(1, std::min(rank, this->samples));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < this->buckets.size(); b++) {
+        seen += this->buckets[b];
+        if (seen >= rank) {
+            return std::min(upperBound(static_cast<int>(b)), this->largest);
+        }
+    }
+    return this->largest;
+}
+
+void LatencyHistogram::clear() {
+    this->buckets.fill(0);
+    this->samples = this->largest = 0;
+}
+
+// ---------- GameServer ----------
+
+struct GameServer::Game {
+    BoardPool::Handle board;
+    vector<Move> moves;         // MOVES batch, reused
+};
+
+struct GameServer::Client {
+    int in;
+    int out;
+    bool socket;                // close on disconnect (stdin/stdout are left open)
+    string partial;             // bytes after the last complete line
+    string replies;             // replies of the current batch
+    bool closing = false;
+};
+
+GameServer::GameServer(size_t threads, const string& saveDirectory) :
+    pool(threads), saveDirectory(saveDirectory) {}
+
+GameServer::~GameServer() = default;
+
+const LatencyHistogram& GameServer::latency() const {
+    return this->latencies;
+}
+
+size_t GameServer::games() const {
+    return this->table.size();
+}
+
+// Requests are grouped by game in first-seen order; games are looked up (and
+// their slots created) here on the calling thread, so workers never touch
+// the table.  A slot left without a board (unknown id, DROP, failed NEW) is
+// erased after the batch.
+void GameServer::handle(const vector<string>& lines, vector<string>& replies) {
+    replies.assign(lines.size(), string());
+    vector<vector<string>> words(lines.size());
+    vector<pair<Game*, vector<size_t>>> groups;
+    unordered_map<Game*, size_t> groupOf;
+    for (size_t i = 0; i < lines.size(); i++) {
+        split(lines[i], words[i]);
+        if (words[i].empty()) {
+            replies[i] = "ERR - empty request";
+            continue;
+        }
+        const string& command = words[i][0];
+        if (command == "STATS") {
+            char text[160];
+            snprintf(text, sizeof(text), "OK stats games=%zu requests=%llu p50_us=%.1f p99_us=%.1f max_us=%.1f",
+                     this->table.size(), static_cast<unsigned long long>(this->latencies.count()),
+                     this->latencies.percentile(50) / 1e3, this->latencies.percentile(99) / 1e3,
+                     this->latencies.max() / 1e3);
+            replies[i] = text;
+        } else if (command == "QUIT" || command == "SHUTDOWN") {
+            replies[i] = "OK bye";
+        } else if (!isGameCommand(command)) {
+            replies[i] = "ERR - unknown command " + command;
+        } else if (words[i].size() < 2) {
+            replies[i] = "ERR - missing game id";
+        } else {
+            unique_ptr<Game>& slot = this->table[words[i][1]];
+            if (!slot) {
+                slot.reset(new Game());
+            }
+            auto found = groupOf.find(slot.get());
+            if (found == groupOf.end()) {
+                found = groupOf.emplace(slot.get(), groups.size()).first;
+                groups.push_back({slot.get(), {}});
+            }
+            groups[found->second].second.push_back(i);
+        }
+    }
+
+    auto runGroup = [&](const pair<Game*, vector<size_t>>& group) {
+        for (size_t i : group.second) {
+            run(*group.first, words[i], replies[i]);
+        }
+    };
+    if (groups.size() == 1) {
+        runGroup(groups[0]);    // not worth a hand-off
+    } else {
+        for (const auto& group : groups) {
+            this->pool.submit([&runGroup, &group] { runGroup(group); });
+        }
+        this->pool.wait();
+    }
+
+    for (auto it = this->table.begin(); it != this->table.end();) {
+        it = it->second->board ? next(it) : this->table.erase(it);
+    }
+}
+
+bool GameServer::savePath(const string& name, string& path) const {
+    if (name.empty() || name == "." || name == ".." ||
+        name.find('/') != string::npos) {
+        return false;
+    }
+    path = this->saveDirectory + "/" + name;
+    return true;
+}
+
+void GameServer::run(Game& game, const vector<string>& words, string& reply) {
+    const string& command = words[0];
+    const string& id = words[1];
+    auto fail = [&](const char* reason) { reply = "ERR " + id + " " + reason; };
+    Board* board = game.board.get();
+
+    if (command == "NEW") {
+        int rows, columns, mines;
+        uint64_t seed;
+        if (board) return fail("game exists");
+        if (words.size() < 5 || words.size() > 6 || !parse(words[2], rows) || !parse(words[3], columns) ||
+            !parse(words[4], mines) || (words.size() == 6 && !parse(words[5], seed))) {
+            return fail("usage: NEW <id> <rows> <cols> <mines> [seed]");
+        }
+        if (!Board::fits(rows, columns, mines)) return fail("bad size");
+        game.board = words.size() == 6 ? this->boards.acquire(rows, columns, mines, seed)
+                                       : this->boards.acquire(rows, columns, mines);
+        reply = "OK " + id;
+        return;
+    }
+    if (command == "LOAD") {
+        string path;
+        if (words.size() != 3) return fail("usage: LOAD <id> <name>");
+        if (this->saveDirectory.empty()) return fail("saving disabled");
+        if (!this->savePath(words[2], path)) return fail("bad save name");
+        ifstream in(path);
+        BoardPool::Handle loaded = board ? BoardPool::Handle() : this->boards.acquire(1, 1, 0, uint64_t{0});
+        Board& target = board ? *board : *loaded;
+        if (!in || target.load(in) != 0) return fail("cannot load");
+        if (loaded) game.board = move(loaded);
+        reply = "OK " + id;
+        return;
+    }
+    if (!board) return fail("no such game");
+
+    if (command == "REVEAL" || command == "FLAG" || command == "CHORD") {
+        Move move;
+        move.type = command == "REVEAL" ? MOVE_REVEAL : command == "FLAG" ? MOVE_TOGGLE : MOVE_CHORD;
+        if (words.size() != 4 || !parse(words[2], move.row) || !parse(words[3], move.col)) {
+            return fail("usage: REVEAL|FLAG|CHORD <id> <row> <col>");
+        }
+        if (!board->inBounds(move.row, move.col)) return fail("out of bounds");
+        game.moves.assign(1, move);
+    } else if (command == "MOVES") {
+        // Check every move before applying any
+        game.moves.clear();
+        if ((words.size() - 2) % 3 != 0) return fail("usage: MOVES <id> (R|F|C <row> <col>)...");
+        for (size_t w = 2; w < words.size(); w += 3) {
+            Move move;
+            const string& type = words[w];
+            if (type == "R" || type == "r") move.type = MOVE_REVEAL;
+            else if (type == "F" || type == "f") move.type = MOVE_TOGGLE;
+            else if (type == "C" || type == "c") move.type = MOVE_CHORD;
+            else return fail("move type must be R, F or C");
+            if (!parse(words[w + 1], move.row) || !parse(words[w + 2], move.col)) {
+                return fail("usage: MOVES <id> (R|F|C <row> <col>)...");
+            }
+            if (!board->inBounds(move.row, move.col)) return fail("out of bounds");
+            game.moves.push_back(move);
+        }
+    } else if (command == "RESET") {
+        int rows = board->getRows(), columns = board->getColumns(), mines = board->getMines();
+        uint64_t seed;
+        size_t n = words.size();
+        bool sized = n == 5 || n == 6;
+        bool seeded = n == 3 || n == 6;
+        if ((!sized && n != 2 && n != 3) ||
+            (sized && (!parse(words[2], rows) || !parse(words[3], columns) || !parse(words[4], mines))) ||
+            (seeded && !parse(words[n - 1], seed))) {
+            return fail("usage: RESET <id> [<rows> <cols> <mines>] [seed]");
+        }
+        if (!Board::fits(rows, columns, mines)) return fail("bad size");
+        if (seeded) {
+            board->reset(rows, columns, mines, seed);
+        } else {
+            board->reset(rows, columns, mines);
+        }
+        reply = "OK " + id;
+        return;
+    } else if (command == "SAVE") {
+        string path;
+        if (words.size() != 3) return fail("usage: SAVE <id> <name>");
+        if (this->saveDirectory.empty()) return fail("saving disabled");
+        if (!this->savePath(words[2], path)) return fail("bad save name");
+        ofstream out(path);
+        if (!out || board->save(out) != 0 || !out.flush()) return fail("cannot save");
+        reply = "OK " + id;
+        return;
+    } else {    // DROP
+        game.board.reset();
+        reply = "OK " + id;
+        return;
+    }
+
+    const vector<TileChange>& diff = board->apply(game.moves);
+    reply.reserve(24 + id.size() + diff.size() * 8);
+    reply = "DIFF ";
+    reply += id;
+    reply += ' ';
+    reply += statusOf(*board);
+    reply += ' ';
+    reply += to_string(diff.size());
+    for (const TileChange& change : diff) {
+        static const char letters[] = {'C', 'R', 'F', 'Q', 'X'};
+        reply += ' ';
+        reply += to_string(change.index);
+        reply += letters[change.state];
+        if (change.state == TileState::REVEALED) {
+            reply += static_cast<char>('0' + change.adjacentMines);
+        }
+    }
+}
+
+int GameServer::serve(int in, int out) {
+    vector<Client> clients;
+    clients.push_back({in, out, false, string(), string()});
+    return this->loop(clients, -1);
+}
+
+int GameServer::serveSocket(const string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    strcpy(address.sun_path, path.c_str());
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return -1;
+    }
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        close(listener);
+        return -1;
+    }
+    vector<Client> clients;
+    int result = this->loop(clients, listener);
+    for (Client& client : clients) {
+        close(client.in);
+    }
+    close(listener);
+    unlink(path.c_str());
+    return result;
+}
+
+// One iteration: wait for input, cut it into lines, run every complete line
+// from every client as one batch, write each client's replies with a single
+// write, then time the requests.  Lines after a client's QUIT are ignored.
+int GameServer::loop(vector<Client>& clients, int listener) {
+    vector<pollfd> fds;
+    vector<string> lines;
+    vector<string> replies;
+    vector<size_t> from;            // client of each line
+    vector<char> buffer(1 << 16);
+    bool stopping = false;
+    int result = 0;
+    while (!stopping && (listener >= 0 || !clients.empty())) {
+        fds.clear();
+        if (listener >= 0) fds.push_back({listener, POLLIN, 0});
+        for (const Client& client : clients) fds.push_back({client.in, POLLIN, 0});
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        Clock::time_point arrived = Clock::now();
+        size_t first = 0;
+        if (listener >= 0) {
+            first = 1;
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(listener, nullptr, nullptr);
+                if (fd >= 0) clients.push_back({fd, fd, true, string(), string()});
+            }
+        }
+
+        lines.clear();
+        from.clear();
+        for (size_t c = 0; c + first < fds.size(); c++) {
+            Client& client = clients[c];
+            if (!(fds[c + first].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            ssize_t n = read(client.in, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                client.closing = true;     // end of input: a last unterminated line still counts
+                if (!client.partial.empty()) client.partial += '\n';
+            } else {
+                client.partial.append(buffer.data(), static_cast<size_t>(n));
+            }
+            size_t start = 0, end;
+            bool quit = false;
+            while (!quit && (end = client.partial.find('\n', start)) != string::npos) {
+                lines.emplace_back(client.partial, start, end - start);
+                from.push_back(c);
+                start = end + 1;
+                vector<string> words;
+                split(lines.back(), words);
+                if (!words.empty() && (words[0] == "QUIT" || words[0] == "SHUTDOWN")) {
+                    quit = client.closing = true;
+                    stopping = stopping || words[0] == "SHUTDOWN";
+                }
+            }
+            client.partial.erase(0, quit ? string::npos : start);
+        }
+        if (lines.empty() && none_of(clients.begin(), clients.end(), [](const Client& c) { return c.closing; })) {
+            continue;
+        }
+
+        handle(lines, replies);
+        for (size_t i = 0; i < lines.size(); i++) {
+            clients[from[i]].replies += replies[i];
+            clients[from[i]].replies += '\n';
+        }
+        for (Client& client : clients) {
+            if (client.replies.empty()) continue;
+            if (writeAll(client.out, client.replies) != 0) {
+                client.closing = true;
+                if (!client.socket) result = -1;
+            }
+            client.replies.clear();
+        }
+        Clock::time_point written = Clock::now();
+        uint64_t ns = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(written - arrived).count());
+        for (size_t i = 0; i < lines.size(); i++) {
+            this->latencies.record(ns);
+        }
+
+        for (size_t c = clients.size(); c-- > 0;) {
+            if (clients[c].closing) {
+                if (clients[c].socket) close(clients[c].in);
+                clients.erase(clients.begin() + static_cast<long>(c));
+            }
+        }
+    }
+    return result;
+}
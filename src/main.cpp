@@ -12,8 +12,22 @@
  *   Arrows / H J K L  → move cursor
  *   Space / Enter     → reveal
  *   f                 → flag / cycle flag (Board::toggleTile)
+ *   c                 → chord: on a number with that many flags around it,
+ *                       reveal the other neighbors (Board::chordTile)
+ *   u / y             → undo / redo the last reveal or flag (Board::undo/redo,
+ *                       64 moves deep)
  *   r                 → restart same config
- *   s                 → save to the current save path
+ *   s                 → save to the current save path (full snapshot)
+ *   i                 → show / hide Board instrumentation (Board::stats(),
+ *                       needs a -DMINESWEEPER_STATS=ON build)
+ *
+ * Every move is also autosaved: the board is written once to the save path
+ * and each reveal/flag is appended to "<save path>.journal" (MoveJournal).
+ * Nothing is written before the first move or save, and a save file that
+ * exists but cannot be restored is never overwritten.
+ *
+ * The first reveal of a game never hits a mine and always opens an area
+ * (Board::setFirstClick(FIRST_CLICK_OPENING)).
  *   q                 → quit
  *
  * Run:
@@ -28,10 +42,15 @@
 
 #include <ncurses.h>
 #include <locale.h>
+#include <cstdio>
 #include <cstdlib>
 #include <string>
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <vector>
 #include "minesweeper/board.hpp"
+#include "minesweeper/move_journal.hpp"
 using namespace std;
 
 struct Config { int rows=16, cols=30, mines=99; };
@@ -64,23 +83,6 @@ static short num_color(int n){
 struct Layout { int top=1, left=1, cellw=2; }; // left/top aligned with small margin
 static Layout layout_for_left(int /*term_r*/,int /*term_c*/,int /*rows*/,int /*cols*/) { return {}; }
 
-static bool check_win(Board& B){
-    for(int r=0;r<B.getRows();++r)
-        for(int c=0;c<B.getColumns();++c){
-            Tile* t=B.getTile(r,c);
-            if(!t->isMine && t->state!=REVEALED) return false;
-        }
-    return true;
-}
-
-static int count_mines(Board& B){
-    int m=0;
-    for(int r=0;r<B.getRows();++r)
-        for(int c=0;c<B.getColumns();++c)
-            if(B.getTile(r,c)->isMine) ++m;
-    return m;
-}
-
 static void draw_frame(const Layout& L,int R,int C){
     attron(COLOR_PAIR(CP_FRAME));
     mvaddch(L.top, L.left,'+'); mvhline(L.top, L.left+1,'-', C*L.cellw);
@@ -92,47 +94,126 @@ static void draw_frame(const Layout& L,int R,int C){
     attroff(COLOR_PAIR(CP_FRAME));
 }
 
-static void draw_board(Board& B,const Layout& L,const Cursor& cur,bool over,int boom_r,int boom_c){
-    int R=B.getRows(), C=B.getColumns(); draw_frame(L,R,C);
-    for(int r=0;r<R;++r)for(int c=0;c<C;++c){
-        int y=L.top+1+r, x=L.left+1+c*L.cellw;
-        Tile* t=B.getTile(r,c);
-        bool on=(r==cur.r && c==cur.c);
-
-        // Always highlight the cursor (even on revealed cells)
-        if(on) attron(A_REVERSE);
-
-        if(t->state==COVERED || t->state==FLAGGED || t->state==QUESTIONED){
-            if(t->state==FLAGGED){ attron(COLOR_PAIR(CP_FLAG)); mvprintw(y,x,"F "); attroff(COLOR_PAIR(CP_FLAG)); }
-            else if(t->state==QUESTIONED){ attron(A_DIM); mvprintw(y,x,"? "); attroff(A_DIM); }
-            else mvprintw(y,x,"[]");
-        }else{ // REVEALED / EXPLODED
-            if(t->isMine){
-                if(over && r==boom_r && c==boom_c){ attron(COLOR_PAIR(CP_EXPLODE)); mvprintw(y,x,"* "); attroff(COLOR_PAIR(CP_EXPLODE)); }
-                else { attron(COLOR_PAIR(CP_MINE)); mvprintw(y,x,"* "); attroff(COLOR_PAIR(CP_MINE)); }
-            }else if(t->adjacentMines==0){
-                mvprintw(y,x,"  ");
-            }else{
-                short cp=num_color((int)t->adjacentMines);
-                attron(COLOR_PAIR(cp)|A_BOLD);
-                mvprintw(y,x,"%u ",t->adjacentMines);
-                attroff(COLOR_PAIR(cp)|A_BOLD);
-            }
+// What a cell looks like on screen.  The renderer keeps the glyph it last
+// drew for every cell and only repaints cells whose glyph changed.
+enum Glyph : uint8_t {
+    G_COVERED, G_FLAG, G_QUESTION, G_EMPTY,
+    G_NUM1, G_NUM8=G_NUM1+7, G_MINE, G_BOOM,
+    G_CURSOR=0x80,          // OR-ed in when the cursor is on the cell
+    G_UNDRAWN=0xff
+};
+
+// Last drawn frame plus the cells that may have changed since
+struct Frame {
+    int rows=-1, cols=-1;
+    vector<uint8_t> glyphs;   // row-major, glyph on screen per cell
+    vector<Cell> dirty;       // candidates for repaint (reveal diff, toggles, cursor)
+    bool full=true;           // clear() and repaint everything (first frame, resize, restart)
+    int painted=0;            // cells repainted by the current draw
+    double last_ms=0;         // draw + refresh time of the previous frame
+    int last_painted=0;       // cells repainted by the previous frame
+};
+
+// Drawing is a template on the board type: Board or a FixedBoard preset (IsBoard)
+template<class BoardT>
+static uint8_t cell_glyph(BoardT& B,int r,int c,const Cursor& cur,bool over,int boom_r,int boom_c){
+    Tile* t=B.getTile(r,c);
+    uint8_t g;
+    if(t->state==FLAGGED) g=G_FLAG;
+    else if(t->state==QUESTIONED) g=G_QUESTION;
+    else if(t->state==COVERED) g=G_COVERED;
+    else if(t->isMine) g=(over && r==boom_r && c==boom_c) ? (uint8_t)G_BOOM : (uint8_t)G_MINE;
+    else g=t->adjacentMines==0 ? (uint8_t)G_EMPTY : (uint8_t)(G_NUM1+t->adjacentMines-1);
+    // Always highlight the cursor (even on revealed cells)
+    if(r==cur.r && c==cur.c) g|=G_CURSOR;
+    return g;
+}
+
+static void paint_cell(uint8_t g,int y,int x){
+    bool on=(g & G_CURSOR)!=0; g&=~G_CURSOR;
+    if(on) attron(A_REVERSE);
+    switch(g){
+        case G_FLAG:     attron(COLOR_PAIR(CP_FLAG)); mvprintw(y,x,"F "); attroff(COLOR_PAIR(CP_FLAG)); break;
+        case G_QUESTION: attron(A_DIM); mvprintw(y,x,"? "); attroff(A_DIM); break;
+        case G_COVERED:  mvprintw(y,x,"[]"); break;
+        case G_EMPTY:    mvprintw(y,x,"  "); break;
+        case G_BOOM:     attron(COLOR_PAIR(CP_EXPLODE)); mvprintw(y,x,"* "); attroff(COLOR_PAIR(CP_EXPLODE)); break;
+        case G_MINE:     attron(COLOR_PAIR(CP_MINE)); mvprintw(y,x,"* "); attroff(COLOR_PAIR(CP_MINE)); break;
+        default: {
+            int n=g-G_NUM1+1; short cp=num_color(n);
+            attron(COLOR_PAIR(cp)|A_BOLD);
+            mvprintw(y,x,"%d ",n);
+            attroff(COLOR_PAIR(cp)|A_BOLD);
         }
+    }
+    if(on) attroff(A_REVERSE);
+}
 
-        if(on) attroff(A_REVERSE);
+template<class BoardT>
+static void draw_board(BoardT& B,const Layout& L,const Cursor& cur,bool over,int boom_r,int boom_c,Frame& F){
+    static_assert(IsBoard<BoardT>::value,"draw_board: not a board type");
+    int R=B.getRows(), C=B.getColumns();
+    F.painted=0;
+    auto repaint=[&](int r,int c){
+        uint8_t g=cell_glyph(B,r,c,cur,over,boom_r,boom_c);
+        uint8_t& shown=F.glyphs[r*C+c];
+        if(g==shown) return;
+        paint_cell(g, L.top+1+r, L.left+1+c*L.cellw);
+        shown=g; ++F.painted;
+    };
+    if(F.full || F.rows!=R || F.cols!=C){
+        clear(); draw_frame(L,R,C);
+        F.rows=R; F.cols=C; F.glyphs.assign((size_t)R*C, G_UNDRAWN);
+        for(int r=0;r<R;++r)for(int c=0;c<C;++c) repaint(r,c);
+        F.full=false;
+    }else{
+        for(Cell cell : F.dirty) if(B.inBounds(cell.row,cell.col)) repaint(cell.row,cell.col);
     }
+    F.dirty.clear();
 }
 
-static void draw_status(const Config& cfg,bool over,bool win,int y,int x){
+static void draw_status(const Config& cfg,int remaining,bool over,bool win,const Frame& F,int y,int x){
     move(y,x); clrtoeol();
     if(over){
         if(win){ attron(COLOR_PAIR(CP_WIN)|A_BOLD); mvprintw(y,x,"You win!  r=replay  s=save  q=quit"); attroff(COLOR_PAIR(CP_WIN)|A_BOLD); }
         else   { attron(COLOR_PAIR(CP_LOSE)|A_BOLD); mvprintw(y,x,"BOOM! You lost. r=replay  s=save  q=quit"); attroff(COLOR_PAIR(CP_LOSE)|A_BOLD); }
     }else{
-        mvprintw(y,x,"Arrows/HJKL move | Space/Enter reveal | f flag | r restart | s save | q quit");
+        mvprintw(y,x,"Arrows/HJKL move | Space/Enter reveal | f flag | c chord | u/y undo/redo | r restart | s save | i stats | q quit");
     }
-    mvprintw(max(0,y-1), x, "Minesweeper %dx%d (%d mines)", cfg.rows, cfg.cols, cfg.mines);
+    move(max(0,y-1),x); clrtoeol();
+    mvprintw(max(0,y-1), x, "Minesweeper %dx%d (%d mines, %d left)", cfg.rows, cfg.cols, cfg.mines, remaining);
+    move(y+1,x); clrtoeol();
+    attron(A_DIM); mvprintw(y+1, x, "last frame %.2f ms, %d cells repainted", F.last_ms, F.last_painted); attroff(A_DIM);
+}
+
+// Board::stats() as a box to the right of the board
+static void draw_stats(const BoardStats& S,int y,int x){
+    auto ms=[](uint64_t ns){ return ns/1e6; };
+    vector<string> lines;
+    char buf[96];
+    auto add=[&](const char* fmt,auto... v){ snprintf(buf,sizeof buf,fmt,v...); lines.push_back(buf); };
+    add("%s","Instrumentation (i)");
+    if(!S.enabled){
+        add("%s","off: build with -DMINESWEEPER_STATS=ON");
+    }else{
+        add("reveals       %10llu",(unsigned long long)S.reveals);
+        add("cascades      %10llu",(unsigned long long)S.cascades);
+        add("  tiles       %10llu",(unsigned long long)S.cascadeTiles);
+        add("  max tiles   %10llu",(unsigned long long)S.maxCascadeTiles);
+        add("  max depth   %10llu",(unsigned long long)S.maxCascadeDepth);
+        add("touched       %10llu",(unsigned long long)S.tilesTouched);
+        add("  max/call    %10llu",(unsigned long long)S.maxTilesTouched);
+        add("toggles       %10llu",(unsigned long long)S.toggles);
+        add("saves         %10llu  %8.2f ms",(unsigned long long)S.saves,ms(S.saveNs));
+        add("  bytes       %10llu",(unsigned long long)S.bytesSaved);
+        add("loads         %10llu  %8.2f ms",(unsigned long long)S.loads,ms(S.loadNs));
+        add("  bytes       %10llu",(unsigned long long)S.bytesLoaded);
+        add("reveal time   %10.2f ms",ms(S.revealNs));
+        add("adjacents     %10.2f ms",ms(S.adjacentsNs));
+    }
+    attron(COLOR_PAIR(CP_FRAME));
+    for(size_t i=0;i<lines.size();++i){ move(y+(int)i,x); clrtoeol(); mvprintw(y+(int)i,x,"%s",lines[i].c_str()); }
+    attroff(COLOR_PAIR(CP_FRAME));
 }
 
 int main(int argc,char** argv){
@@ -145,16 +226,26 @@ int main(int argc,char** argv){
     bool over=false, win=false; int boom_r=-1, boom_c=-1;
 
     // --- CLI parsing ---
+    if(argc == 2) save_path = argv[1];
+    MoveJournal journal(save_path, save_path + ".journal");
+    bool restored = false;
+    bool autosave = true;     // false: never touch the save path
+
     if(argc == 2){
-        save_path = argv[1];
-        ifstream ifs(save_path);
-        if(board.load(ifs)){
+        // base snapshot plus any autosaved moves on top of it
+        if(journal.restore(board) == 0){
+            restored = true;
             // infer config from the loaded board
             cfg.rows  = board.getRows();
             cfg.cols  = board.getColumns();
-            cfg.mines = count_mines(board);
+            cfg.mines = board.getMines();
+            over = board.isLost() || board.isWon();
+            win  = board.isWon();
+        } else if(filesystem::exists(save_path)){
+            // unreadable save: play on the defaults, but never write over it
+            autosave = false;
         } else {
-            // if load fails, keep defaults but remember the save path
+            // no such file yet: start a new game that saves there
         }
     } else if(argc == 4){
         cfg.rows  = max(5, atoi(argv[1]));
@@ -165,23 +256,54 @@ int main(int argc,char** argv){
     } else {
         // no args: defaults already set, board constructed above
     }
+    // the base snapshot is written on the first move or save, so merely
+    // starting a game never replaces an earlier save
+    bool journaling = restored;
+    auto snapshot=[&]{
+        if(!autosave) return -1;
+        int rc = journal.compact(board);
+        if(rc==0) journaling=true;
+        return rc;
+    };
+    auto autosave_move=[&](MoveType type,int r,int c){
+        if(journaling) journal.record(board, type, r, c);
+        else snapshot();
+    };
+    board.setFirstClick(FIRST_CLICK_OPENING);
+    board.setUndoDepth(64);
+    // first reveal still to come? (it may move mines, see below)
+    auto unopened=[&]{ return board.revealedTiles()==0; };
+    bool fresh=unopened();
+    // the exploded tile among cells a move just changed (chord, undo, redo)
+    auto find_boom=[&](const vector<Cell>& cells,size_t from){
+        boom_r=boom_c=-1;
+        for(size_t i=from;i<cells.size();++i)
+            if(board.getTile(cells[i].row,cells[i].col)->state==EXPLODED){ boom_r=cells[i].row; boom_c=cells[i].col; }
+    };
 
     // --- ncurses init ---
     initscr(); cbreak(); noecho(); keypad(stdscr, TRUE); curs_set(0);
     if(has_colors()) init_colors();
 
+    Frame frame;
+    bool show_stats=false;
     bool running=true;
     while(running){
         int tr,tc; getmaxyx(stdscr,tr,tc);
         Layout L = layout_for_left(tr,tc,board.getRows(),board.getColumns());
         if(!board.inBounds(cur.r,cur.c)) cur={0,0};
 
-        clear();
-        draw_board(board,L,cur,over,boom_r,boom_c);
-        draw_status(cfg,over,win, L.top+2+board.getRows(), L.left);
+        auto t0=chrono::steady_clock::now();
+        draw_board(board,L,cur,over,boom_r,boom_c,frame);
+        draw_status(cfg,board.minesRemaining(),over,win,frame, L.top+2+board.getRows(), L.left);
+        if(show_stats) draw_stats(board.stats(), L.top, L.left+3+board.getColumns()*L.cellw);
         refresh();
+        frame.last_ms=chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+        frame.last_painted=frame.painted;
 
         int ch=getch();
+        // the cursor cell repaints before and after any key (old + new position)
+        frame.dirty.push_back({cur.r,cur.c});
         switch(ch){
             // movement
             case KEY_UP: case 'k': if(cur.r>0) --cur.r; break;
@@ -192,39 +314,81 @@ int main(int argc,char** argv){
             // reveal
             case ' ': case '\n':
                 if(!over){
-                    bool boom=board.revealTile(cur.r,cur.c);
+                    size_t before=frame.dirty.size();
+                    bool boom=board.revealTile(cur.r,cur.c,frame.dirty);
+                    if(fresh && frame.dirty.size()>before){
+                        // the first reveal may have moved mines: snapshot the result so
+                        // replaying the journal never depends on the first-click policy
+                        fresh=false;
+                        snapshot();
+                    }else{
+                        autosave_move(MOVE_REVEAL, cur.r, cur.c);
+                    }
                     if(boom){ over=true; win=false; boom_r=cur.r; boom_c=cur.c; }
-                    else if(check_win(board)){ over=true; win=true; }
+                    else if(board.isWon()){ over=true; win=true; }
+                } break;
+
+            // chord
+            case 'c':
+                if(!over){
+                    size_t before=frame.dirty.size();
+                    bool boom=board.chordTile(cur.r,cur.c,frame.dirty);
+                    if(frame.dirty.size()>before) autosave_move(MOVE_CHORD, cur.r, cur.c);
+                    if(boom){ over=true; win=false; find_boom(frame.dirty,before); }
+                    else if(board.isWon()){ over=true; win=true; }
                 } break;
 
             // flag
             case 'f':
-                if(!over) board.toggleTile(cur.r,cur.c);
-                break;
+                if(!over){
+                    board.toggleTile(cur.r,cur.c);
+                    autosave_move(MOVE_TOGGLE, cur.r, cur.c);
+                } break;
+
+            // undo / redo (allowed after game over, to retry the last move)
+            case 'u': case 'y': {
+                size_t before=frame.dirty.size();
+                bool stepped = ch=='u' ? board.undo(frame.dirty) : board.redo(frame.dirty);
+                if(stepped){
+                    // the journal only replays forward moves: snapshot instead
+                    snapshot();
+                    fresh=unopened();
+                    over=board.isLost() || board.isWon();
+                    win=board.isWon();
+                    find_boom(frame.dirty,before);
+                }
+            } break;
 
             // restart
             case 'r':
                 //board = Board(cfg.rows,cfg.cols,cfg.mines);
                 board.reset(cfg.rows,cfg.cols,cfg.mines);
+                if(journaling) snapshot();
+                fresh=true;
+                frame.full=true;
                 cur={0,0}; over=false; win=false; boom_r=boom_c=-1;
                 break;
 
             // save
             case 's': {
-                ofstream ofs(save_path);
-                bool ok = board.save(ofs);   // uses your Board::save(...)
+                // full snapshot; also empties the autosave journal
+                bool ok = snapshot() == 0;
                 int y = L.top+3+board.getRows();
                 move(y, L.left); clrtoeol();
-                mvprintw(y, L.left, ok ? "Saved to %s" : "Save failed: %s", save_path.c_str());
+                mvprintw(y, L.left, ok ? "Saved to %s" : autosave ? "Save failed: %s" : "Not overwriting unreadable %s", save_path.c_str());
                 refresh(); napms(500);
             } break;
 
+            // instrumentation overlay (hiding it repaints what it covered)
+            case 'i': show_stats=!show_stats; frame.full=true; break;
+
             case 'q': running=false; break;
 #ifdef KEY_RESIZE
-            case KEY_RESIZE: break;
+            case KEY_RESIZE: frame.full=true; break;
 #endif
             default: break;
         }
+        frame.dirty.push_back({cur.r,cur.c});
     }
 
     endwin();
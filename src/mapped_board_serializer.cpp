@@ -0,0 +1,93 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "minesweeper/mapped_board_serializer.hpp"
+#include "minesweeper/board.hpp"
+
+namespace {
+    const char MAGIC[4] = {'M', 'S', 'W', 'M'};
+
+    // In-memory byte of a Tile with every field set to a distinct value
+    uint8_t tileProbe() {
+        Tile tile;
+        tile.state = TileState::EXPLODED;
+        tile.isMine = true;
+        tile.adjacentMines = 6;
+        uint8_t byte;
+        memcpy(&byte, &tile, sizeof(byte));
+        return byte;
+    }
+}
+
+MappedBoardHeader MappedBoardSerializer::makeHeader(const Board& board) {
+    MappedBoardHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.tileProbe = tileProbe();
+    header.rows = board.rows;
+    header.columns = board.columns;
+    header.mines = board.mines;
+    header.revealedSafe = board.revealedSafe;
+    header.flagged = board.flagged;
+    header.questioned = board.questioned;
+    header.exploded = board.exploded;
+    return header;
+}
+
+int MappedBoardSerializer::checkHeader(const MappedBoardHeader& header, size_t available) {
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        return -1; // not ours, or a version we do not understand
+    }
+    if (header.tileProbe != tileProbe()) {
+        return -1; // written by a build that packs tiles differently
+    }
+    if (header.rows <= 0 || header.columns <= 0 || header.mines < 0 ||
+        header.mines > static_cast<long long>(header.rows) * header.columns ||
+        (static_cast<long long>(header.rows) + 2) * (static_cast<long long>(header.columns) + 2) >
+            numeric_limits<int32_t>::max()) {
+        return -1; // invalid dimensions
+    }
+    size_t stored = (static_cast<size_t>(header.rows) + 2) * (static_cast<size_t>(header.columns) + 2);
+    return available >= sizeof(header) + stored ? 0 : -1;
+}
+
+int MappedBoardSerializer::save(Board& board, std::ostream& out) {
+    MappedBoardHeader header = makeHeader(board);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    // Tiles exactly as they are laid out in memory, border and all
+    out.write(reinterpret_cast<const char*>(board.tiles.data()),
+              static_cast<std::streamsize>(board.tiles.size()));
+    return out ? 0 : -1;
+}
+
+int MappedBoardSerializer::load(Board& board, std::istream& in) {
+    MappedBoardHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return -1; // truncated header
+    }
+    if (checkHeader(header, numeric_limits<size_t>::max()) != 0) {
+        return -1;
+    }
+
+    // Read into a buffer first so a bad file leaves `board` alone
+    size_t stored = (static_cast<size_t>(header.rows) + 2) * (static_cast<size_t>(header.columns) + 2);
+    std::vector<char> payload(stored);
+    if (!in.read(payload.data(), static_cast<std::streamsize>(stored))) {
+        return -1; // truncated tile data
+    }
+    if (!Board::bordered(reinterpret_cast<const Tile*>(payload.data()), header.rows, header.columns)) {
+        return -1; // damaged sentinel border
+    }
+    board.clear(header.rows, header.columns, header.mines);
+    memcpy(static_cast<void*>(board.tiles.data()), payload.data(), stored);
+    return 0; // success
+}
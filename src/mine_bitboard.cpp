@@ -0,0 +1,225 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include <cstring>
+#include "minesweeper/mine_bitboard.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MS_AVX2_KERNEL 1
+#endif
+
+using namespace std;
+
+namespace {
+
+// Add eight one-bit planes into a 4-bit counter (b3 b2 b1 b0), bit-sliced so
+// every bit position is an independent tile.  V is uint64_t for the scalar
+// kernel or a 4 x uint64_t vector for AVX2.
+template <typename V>
+inline void addNeighbors(const V& ul, const V& u, const V& ur, const V& l, const V& r,
+                         const V& dl, const V& d, const V& dr,
+                         V& b0, V& b1, V& b2, V& b3) {
+    // Ones: two full adders and a half adder, then one more full adder
+    V s1 = ul ^ u ^ ur, c1 = (ul & u) | (ur & (ul ^ u));
+    V s2 = l ^ r ^ dl,  c2 = (l & r)  | (dl & (l ^ r));
+    V s3 = d ^ dr,      c3 = d & dr;
+    b0 = s1 ^ s2 ^ s3;
+    V cA = (s1 & s2) | (s3 & (s1 ^ s2));
+    // Twos: c1 + c2 + c3 + cA
+    V t = c1 ^ c2 ^ c3, cB = (c1 & c2) | (c3 & (c1 ^ c2));
+    b1 = t ^ cA;
+    V cC = t & cA;
+    // Fours and eights
+    b2 = cB ^ cC;
+    b3 = cB & cC;
+}
+
+// Count neighbors for words [from, to) of one row.  up/mid/down point at the
+// first data word of their rows; index -1 and `words` are zero guards.
+void countRowScalar(const uint64_t* up, const uint64_t* mid, const uint64_t* down,
+                    int from, int to, uint64_t* b0, uint64_t* b1, uint64_t* b2, uint64_t* b3) {
+    for (int w = from; w < to; w++) {
+        addNeighbors<uint64_t>(
+            (up[w] << 1) | (up[w - 1] >> 63), up[w], (up[w] >> 1) | (up[w + 1] << 63),
+            (mid[w] << 1) | (mid[w - 1] >> 63), (mid[w] >> 1) | (mid[w + 1] << 63),
+            (down[w] << 1) | (down[w - 1] >> 63), down[w], (down[w] >> 1) | (down[w + 1] << 63),
+            b0[w], b1[w], b2[w], b3[w]);
+    }
+}
+
+#ifdef MS_AVX2_KERNEL
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+// Same as countRowScalar, four words per step; the tail goes to the scalar kernel
+__attribute__((target("avx2")))
+void countRowAvx2(const uint64_t* up, const uint64_t* mid, const uint64_t* down,
+                  int words, uint64_t* b0, uint64_t* b1, uint64_t* b2, uint64_t* b3) {
+    int w = 0;
+    for (; w + 4 <= words; w += 4) {
+        v4u64 u, m, d, uP, mP, dP, uN, mN, dN;
+        memcpy(&u, up + w, sizeof(u));
+        memcpy(&m, mid + w, sizeof(m));
+        memcpy(&d, down + w, sizeof(d));
+        memcpy(&uP, up + w - 1, sizeof(uP));
+        memcpy(&mP, mid + w - 1, sizeof(mP));
+        memcpy(&dP, down + w - 1, sizeof(dP));
+        memcpy(&uN, up + w + 1, sizeof(uN));
+        memcpy(&mN, mid + w + 1, sizeof(mN));
+        memcpy(&dN, down + w + 1, sizeof(dN));
+        v4u64 o0, o1, o2, o3;
+        addNeighbors<v4u64>(
+            (u << 1) | (uP >> 63), u, (u >> 1) | (uN << 63),
+            (m << 1) | (mP >> 63), (m >> 1) | (mN << 63),
+            (d << 1) | (dP >> 63), d, (d >> 1) | (dN << 63),
+            o0, o1, o2, o3);
+        memcpy(b0 + w, &o0, sizeof(o0));
+        memcpy(b1 + w, &o1, sizeof(o1));
+        memcpy(b2 + w, &o2, sizeof(o2));
+        memcpy(b3 + w, &o3, sizeof(o3));
+    }
+    countRowScalar(up, mid, down, w, words, b0, b1, b2, b3);
+}
+#endif
+
+// spread[b] has byte k set to bit k of b; turns 8 plane bits into 8 counts
+struct SpreadTable {
+    uint64_t bytes[256];
+    SpreadTable() {
+        for (int b = 0; b < 256; b++) {
+            bytes[b] = 0;
+            for (int k = 0; k < 8; k++) {
+                bytes[b] |= static_cast<uint64_t>((b >> k) & 1) << (8 * k);
+            }
+        }
+    }
+};
+const SpreadTable kSpread;
+
+// Where the compiler put Tile's bitfields inside its byte, so 8 tiles can be
+// read or patched with one 64-bit load/store
+struct TileBits {
+    int mineShift = 0;
+    int countShift = 0;
+    TileBits() {
+        Tile t;
+        uint8_t byte;
+        t.isMine = true;
+        memcpy(&byte, &t, 1);
+        while (!((byte >> mineShift) & 1)) mineShift++;
+        t.isMine = false;
+        t.adjacentMines = 1;
+        memcpy(&byte, &t, 1);
+        while (!((byte >> countShift) & 1)) countShift++;
+    }
+};
+const TileBits kTileBits;
+
+const uint64_t kLowBytes = 0x0101010101010101ULL;
+
+// @return one byte per tile, 1 where the tile is a mine
+inline uint64_t mineBytes(uint64_t tileBytes) {
+    return (tileBytes >> kTileBits.mineShift) & kLowBytes;
+}
+
+// @return bit k set when byte k is 1 (bytes must be 0 or 1)
+inline uint64_t packBytes(uint64_t bytes) {
+    return (bytes * 0x0102040810204080ULL) >> 56;
+}
+
+} // namespace
+
+void MineBitboard::load(const Tile* tiles, int rows, int columns, int rowStride) {
+    this->load(tiles, rows, columns, rowStride, nullptr, nullptr);
+}
+
+// The halo rows go where the zero guard rows would be
+void MineBitboard::load(const Tile* tiles, int rows, int columns, int rowStride,
+                        const Tile* above, const Tile* below) {
+    this->rows = rows;
+    this->columns = columns;
+    this->words = (columns + 63) / 64;
+    this->stride = this->words + 2;
+    this->bits.assign(static_cast<size_t>(rows + 2) * this->stride, 0);
+    if (above) this->packRow(above, 0);
+    for (int r = 0; r < rows; r++) {
+        this->packRow(tiles + static_cast<size_t>(r) * rowStride, r + 1);
+    }
+    if (below) this->packRow(below, rows + 1);
+}
+
+void MineBitboard::packRow(const Tile* row, int stored) {
+    uint64_t* out = &this->bits[static_cast<size_t>(stored) * this->stride + 1];
+    int c = 0;
+    for (; c + 8 <= this->columns; c += 8) {
+        uint64_t bytes;
+        memcpy(&bytes, row + c, 8);
+        out[c >> 6] |= packBytes(mineBytes(bytes)) << (c & 63);
+    }
+    for (; c < this->columns; c++) {
+        out[c >> 6] |= static_cast<uint64_t>(row[c].isMine) << (c & 63);
+    }
+}
+
+bool MineBitboard::isMine(int row, int col) const {
+    return (rowWords(row)[col >> 6] >> (col & 63)) & 1;
+}
+
+void MineBitboard::writeAdjacents(Tile* tiles, int rowStride, bool useSimd) const {
+    vector<uint64_t> b0(this->words), b1(this->words), b2(this->words), b3(this->words);
+#ifdef MS_AVX2_KERNEL
+    bool simd = useSimd && simdAvailable();
+#else
+    (void)useSimd;
+#endif
+    for (int r = 0; r < this->rows; r++) {
+        const uint64_t* up = rowWords(r - 1);
+        const uint64_t* mid = rowWords(r);
+        const uint64_t* down = rowWords(r + 1);
+#ifdef MS_AVX2_KERNEL
+        if (simd) {
+            countRowAvx2(up, mid, down, this->words, b0.data(), b1.data(), b2.data(), b3.data());
+        } else
+#endif
+        {
+            countRowScalar(up, mid, down, 0, this->words, b0.data(), b1.data(), b2.data(), b3.data());
+        }
+
+        // Unpack the four count planes into the tiles of this row, 8 at a time
+        Tile* row = tiles + static_cast<size_t>(r) * rowStride;
+        const uint64_t countMask = (0xfULL * kLowBytes) << kTileBits.countShift;
+        for (int c0 = 0; c0 < this->columns; c0 += 8) {
+            int w = c0 >> 6, shift = c0 & 63;
+            uint64_t counts = kSpread.bytes[(b0[w] >> shift) & 0xff]
+                            | kSpread.bytes[(b1[w] >> shift) & 0xff] << 1
+                            | kSpread.bytes[(b2[w] >> shift) & 0xff] << 2
+                            | kSpread.bytes[(b3[w] >> shift) & 0xff] << 3;
+            if (c0 + 8 <= this->columns) {
+                uint64_t bytes;
+                memcpy(&bytes, row + c0, 8);
+                // Only patch the count bits of non-mine tiles
+                uint64_t keep = mineBytes(bytes) * 0xff;
+                uint64_t patch = countMask & ~keep;
+                bytes = (bytes & ~patch) | ((counts << kTileBits.countShift) & patch);
+                memcpy(static_cast<void*>(row + c0), &bytes, 8);
+            } else {
+                for (int c = c0; c < this->columns; c++, counts >>= 8) {
+                    if (!row[c].isMine) row[c].adjacentMines = counts & 0xf;
+                }
+            }
+        }
+    }
+}
+
+bool MineBitboard::simdAvailable() {
+#ifdef MS_AVX2_KERNEL
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,95 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include "minesweeper/move_history.hpp"
+
+using namespace std;
+
+MoveHistory::MoveHistory(size_t depth) : limit(depth) {}
+
+void MoveHistory::setDepth(size_t depth) {
+    this->limit = depth;
+    this->trim();
+}
+
+void MoveHistory::clear() {
+    this->arena.clear();
+    this->steps.clear();
+    this->base = this->pending = this->cursor = 0;
+}
+
+// Undone moves sit between the last kept move and the new one, so the new
+// changes slide down over them (O(changes in the move)).
+void MoveHistory::commit(const Tile* tiles) {
+    size_t count = this->arena.size() - this->pending;
+    if (count == 0 || this->limit == 0) {
+        this->arena.resize(this->pending);
+        return;
+    }
+    size_t start = this->pending;
+    if (this->cursor < this->steps.size()) {
+        start = this->steps[this->cursor].begin;
+        move(this->arena.begin() + this->pending, this->arena.end(), this->arena.begin() + start);
+        this->arena.resize(start + count);
+        this->steps.resize(this->cursor);
+    }
+    for (size_t i = start; i < start + count; i++) {
+        this->arena[i].after = tiles[this->arena[i].index];
+    }
+    this->steps.push_back({start, start + count});
+    this->cursor++;
+    this->trim();
+}
+
+bool MoveHistory::undo(const Change*& first, size_t& count) {
+    if (this->cursor == 0) {
+        return false;
+    }
+    const Step& step = this->steps[--this->cursor];
+    first = this->arena.data() + step.begin;
+    count = step.end - step.begin;
+    return true;
+}
+
+bool MoveHistory::redo(const Change*& first, size_t& count) {
+    if (this->cursor == this->steps.size()) {
+        return false;
+    }
+    const Step& step = this->steps[this->cursor++];
+    first = this->arena.data() + step.begin;
+    count = step.end - step.begin;
+    return true;
+}
+
+// Dropping the oldest move only moves `base`; the arena is compacted once
+// the dead prefix outgrows the live part, so each change is copied O(1)
+// times on average.
+void MoveHistory::trim() {
+    size_t drop = this->steps.size() > this->limit ? this->steps.size() - this->limit : 0;
+    size_t oldest = min(drop, this->cursor);
+    this->steps.resize(this->steps.size() - (drop - oldest));    // newest redo moves
+    if (oldest > 0) {
+        this->steps.erase(this->steps.begin(), this->steps.begin() + oldest);
+        this->cursor -= oldest;
+        this->base = this->steps.empty() ? this->arena.size() : this->steps.front().begin;
+    }
+    if (this->steps.empty()) {
+        this->arena.clear();
+        this->base = 0;
+        return;
+    }
+    this->arena.resize(this->steps.back().end);
+    if (this->base > this->arena.size() - this->base) {
+        this->arena.erase(this->arena.begin(), this->arena.begin() + this->base);
+        for (Step& step : this->steps) {
+            step.begin -= this->base;
+            step.end -= this->base;
+        }
+        this->base = 0;
+    }
+}
@@ -0,0 +1,132 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include "minesweeper/move_journal.hpp"
+
+using namespace std;
+
+namespace {
+    const char MAGIC[4] = {'M', 'S', 'W', 'J'};
+    const size_t HEADER_SIZE = 8;
+    const size_t RECORD_SIZE = 9;
+
+    void putU32(char* p, uint32_t v) {
+        for (int i = 0; i < 4; i++) p[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+    }
+
+    uint32_t getU32(const char* p) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) v |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+        return v;
+    }
+}
+
+MoveJournal::MoveJournal(const string& basePath, const string& journalPath, size_t compactAfter) :
+    basePath(basePath), journalPath(journalPath), compactAfter(compactAfter) {}
+
+size_t MoveJournal::length() const {
+    return this->records;
+}
+
+int MoveJournal::openEmptyJournal() {
+    this->journal.close();
+    this->journal.clear();
+    this->journal.open(this->journalPath, ios::binary | ios::trunc);
+    char header[HEADER_SIZE];
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    putU32(&header[4], VERSION);
+    this->journal.write(header, HEADER_SIZE);
+    this->journal.flush();
+    this->records = 0;
+    return this->journal ? 0 : -1;
+}
+
+int MoveJournal::begin(Board& board) {
+    return this->compact(board);
+}
+
+// The new base goes to a temp file first and the journal is emptied before
+// the rename.  A crash at any point leaves a base/journal pair that replays
+// to a state the game really was in (possibly a few moves old), never one
+// where the same moves get applied twice.
+int MoveJournal::compact(Board& board) {
+    string tempPath = this->basePath + ".tmp";
+    {
+        ofstream base(tempPath, ios::binary | ios::trunc);
+        if (!base || board.save(base) != 0 || !base.flush()) {
+            return -1;
+        }
+    }
+    if (this->openEmptyJournal() != 0) {
+        return -1;
+    }
+    return rename(tempPath.c_str(), this->basePath.c_str()) == 0 ? 0 : -1;
+}
+
+int MoveJournal::record(Board& board, MoveType type, int row, int col) {
+    char entry[RECORD_SIZE];
+    entry[0] = static_cast<char>(type);
+    putU32(&entry[1], static_cast<uint32_t>(row));
+    putU32(&entry[5], static_cast<uint32_t>(col));
+    this->journal.write(entry, RECORD_SIZE);
+    this->journal.flush();
+    if (!this->journal) {
+        return -1;
+    }
+    if (++this->records >= this->compactAfter) {
+        return this->compact(board);
+    }
+    return 0;
+}
+
+int MoveJournal::restore(Board& board) {
+    {
+        ifstream base(this->basePath, ios::binary);
+        if (!base || board.load(base) != 0) {
+            return -1;
+        }
+    }
+
+    // Replay whatever complete records the journal holds
+    ifstream in(this->journalPath, ios::binary);
+    vector<char> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    if (bytes.size() < HEADER_SIZE || memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        getU32(&bytes[4]) != VERSION) {
+        return this->openEmptyJournal();
+    }
+    size_t replayed = 0;
+    for (size_t at = HEADER_SIZE; at + RECORD_SIZE <= bytes.size(); at += RECORD_SIZE) {
+        int row = static_cast<int>(getU32(&bytes[at + 1]));
+        int col = static_cast<int>(getU32(&bytes[at + 5]));
+        char type = bytes[at];
+        if (!board.inBounds(row, col) || (type != MOVE_REVEAL && type != MOVE_TOGGLE && type != MOVE_CHORD)) {
+            break; // garbage from here on
+        }
+        if (type == MOVE_REVEAL) {
+            board.revealTile(row, col);
+        } else if (type == MOVE_CHORD) {
+            board.chordTile(row, col);
+        } else {
+            board.toggleTile(row, col);
+        }
+        replayed++;
+    }
+
+    // Drop any torn record and keep appending after the good ones
+    error_code ignored;
+    filesystem::resize_file(this->journalPath, HEADER_SIZE + replayed * RECORD_SIZE, ignored);
+    this->journal.close();
+    this->journal.clear();
+    this->journal.open(this->journalPath, ios::binary | ios::app);
+    this->records = replayed;
+    return this->journal ? 0 : -1;
+}
@@ -0,0 +1,157 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include "minesweeper/no_guess_generator.hpp"
+#include "minesweeper/solver.hpp"
+
+using namespace std;
+
+namespace {
+    // SplitMix64 finalizer: a cheap, well-mixed 64-bit hash
+    uint64_t mix64(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // How many solver moves between checks for a better (lower) winner
+    const int CANCEL_CHECK = 32;
+
+    // State shared by the workers of one generate() call
+    struct Search {
+        int rows;
+        int columns;
+        int mineCount;
+        Cell firstClick;
+        uint64_t seed;
+        uint64_t maxAttempts;
+        vector<int> allowed;                // tiles outside the first click's 3x3
+        atomic<uint64_t> next{0};           // next attempt number to claim
+        atomic<uint64_t> best{UINT64_MAX};  // lowest attempt that passed so far
+        atomic<uint64_t> tried{0};
+    };
+
+    // Candidate layout `attempt`: Floyd's sampling over the allowed tiles
+    void candidate(const Search& search, uint64_t attempt, vector<uint8_t>& taken, vector<Cell>& mines) {
+        std::mt19937_64 rng(mix64(search.seed ^ mix64(attempt)));
+        int available = static_cast<int>(search.allowed.size());
+        mines.clear();
+        for (int j = available - search.mineCount; j < available; j++) {
+            uniform_int_distribution<int> pick(0, j);
+            int t = pick(rng);
+            if (taken[t]) {
+                t = j;
+            }
+            taken[t] = 1;
+            int tile = search.allowed[t];
+            mines.push_back({tile / search.columns, tile % search.columns});
+        }
+        // Clear the marks for the next candidate
+        fill(taken.begin(), taken.end(), 0);
+    }
+
+    // Play the board with the solver from the first click
+    // @return true if it is won without a guess; false on a guess or when a
+    //         lower attempt has already passed
+    bool solvable(Board& board, Solver& solver, const Search& search, uint64_t attempt,
+                  vector<Cell>& changed) {
+        changed.clear();
+        board.revealTile(search.firstClick.row, search.firstClick.col, changed);
+        solver.update(changed);
+        for (int moves = 1; !board.isWon(); moves++) {
+            if (moves % CANCEL_CHECK == 0 && search.best.load(memory_order_relaxed) < attempt) {
+                return false;
+            }
+            solver.solve();
+            Cell safe;
+            if (!solver.nextSafe(safe)) {
+                return false;
+            }
+            changed.clear();
+            board.revealTile(safe.row, safe.col, changed);
+            solver.update(changed);
+        }
+        return true;
+    }
+
+    void worker(Search& search) {
+        Board board(search.rows, search.columns, 0, uint64_t{0});
+        Solver solver(board);
+        vector<uint8_t> taken(search.allowed.size(), 0);
+        vector<Cell> mines;
+        vector<Cell> changed;
+        while (true) {
+            uint64_t attempt = search.next.fetch_add(1);
+            if (attempt >= search.maxAttempts || attempt >= search.best.load()) {
+                return;
+            }
+            search.tried++;
+            candidate(search, attempt, taken, mines);
+            board.reset(search.rows, search.columns, mines);
+            solver.reset();
+            if (solvable(board, solver, search, attempt, changed)) {
+                uint64_t current = search.best.load();
+                while (attempt < current && !search.best.compare_exchange_weak(current, attempt)) {
+                }
+            }
+        }
+    }
+}
+
+NoGuessGenerator::NoGuessGenerator(ThreadPool* pool) : pool(pool) {}
+
+void NoGuessGenerator::setMaxAttempts(uint64_t attempts) {
+    this->maxAttempts = attempts;
+}
+
+uint64_t NoGuessGenerator::attempts() const {
+    return this->lastAttempts;
+}
+
+int NoGuessGenerator::generate(int rows, int columns, int mineCount, Cell firstClick, uint64_t seed,
+                               vector<Cell>& mines) {
+    Search search;
+    search.rows = rows;
+    search.columns = columns;
+    search.mineCount = mineCount;
+    search.firstClick = firstClick;
+    search.seed = seed;
+    search.maxAttempts = this->maxAttempts;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            if (abs(r - firstClick.row) > 1 || abs(c - firstClick.col) > 1) {
+                search.allowed.push_back(r * columns + c);
+            }
+        }
+    }
+    this->lastAttempts = 0;
+    if (mineCount < 0 || mineCount > static_cast<int>(search.allowed.size()) ||
+        firstClick.row < 0 || firstClick.row >= rows || firstClick.col < 0 || firstClick.col >= columns) {
+        return -1;
+    }
+
+    size_t workers = this->pool == nullptr ? 1 : this->pool->size();
+    if (workers <= 1) {
+        worker(search);
+    } else {
+        // Waits only for this search, so generate() may run inside a pool task
+        this->pool->parallelFor(workers, [&search](size_t) { worker(search); });
+    }
+    this->lastAttempts = search.tried.load();
+
+    uint64_t best = search.best.load();
+    if (best == UINT64_MAX) {
+        return -1;
+    }
+    vector<uint8_t> taken(search.allowed.size(), 0);
+    candidate(search, best, taken, mines);
+    return 0;
+}
@@ -0,0 +1,648 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include "minesweeper/probability_engine.hpp"
+
+using namespace std;
+
+namespace {
+    typedef vector<double> Poly;          // [k] = weight of layouts with k mines
+    typedef chrono::steady_clock Clock;
+
+    // Residuals of the open constraints are packed 4 bits each into a DP key
+    const size_t MAX_OPEN = 16;
+
+    // Forward tables bigger than this many doubles make a component approximate
+    const size_t MAX_TABLE = size_t(1) << 22;
+
+    // Counts above 2^1000 would overflow the unscaled DP
+    const size_t MAX_COMPONENT = 1000;
+
+    // Work (multiply-adds) allowed for combining the components exactly
+    const double MAX_COMBINE = 1e8;
+
+    // A revealed count: `target` mines among `size` frontier vars
+    struct FrontierConstraint {
+        int target;
+        int size;
+        int vars[8];
+    };
+
+    // One independent part of the frontier
+    struct Component {
+        vector<int> vars;               // frontier var ids, in DP order once enumerated
+        vector<int> constraints;        // ids into the constraint list
+        bool exact = false;
+        Poly weight;                    // [k] = layouts of this component with k mines
+        Poly others;                    // [k] = weight of everything else given k mines here
+        vector<double> probability;     // per entry of vars
+
+        // DP tables, kept between the forward and the backward pass
+        vector<int> first, last, target;                // per local constraint
+        vector<vector<pair<int, int>>> varCons;         // per var: (local constraint, vars of it left after)
+        vector<vector<int>> open;                       // per layer: local constraints with residuals in the key
+        vector<vector<uint64_t>> keys;                  // per layer: state -> key
+        vector<vector<array<int, 2>>> successor;        // per layer and state: next state for x = 0/1, -1 if infeasible
+        vector<vector<Poly>> forward;                   // per layer and state: layouts of the vars before it
+    };
+
+    // Everything compute() shares between components (read-only while they run)
+    struct Frontier {
+        vector<FrontierConstraint> constraints;
+        vector<vector<int>> varConstraints;     // per var: constraint ids
+        vector<int> tileOf;                     // per var: tile index
+        vector<int> position;                   // per var: index in its component's order
+        vector<int> localId;                    // per constraint: index in its component
+    };
+
+    Poly convolve(const Poly& a, const Poly& b) {
+        Poly out(a.size() + b.size() - 1, 0.0);
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i] == 0.0) {
+                continue;
+            }
+            for (size_t j = 0; j < b.size(); j++) {
+                out[i + j] += a[i] * b[j];
+            }
+        }
+        return out;
+    }
+
+    // Scale so the largest entry is 1 (the common factor cancels out)
+    void normalize(Poly& p) {
+        double top = *max_element(p.begin(), p.end());
+        if (top > 0.0) {
+            for (double& x : p) {
+                x /= top;
+            }
+        }
+    }
+
+    // lgamma() without its write to the global signgam, which races when
+    // engines run compute() on several threads at once
+    double logGamma(double x) {
+        int sign;
+        return lgamma_r(x, &sign);
+    }
+
+    // Run body(0..count-1) on the pool (and this thread), or inline without one
+    void parallelFor(ThreadPool* pool, size_t count, const function<void(size_t)>& body) {
+        if (pool == nullptr || pool->size() <= 1 || count <= 1) {
+            for (size_t i = 0; i < count; i++) {
+                body(i);
+            }
+            return;
+        }
+        pool->parallelFor(count, body);
+    }
+
+    // Residual of local constraint j in `key` of a layer with open set `open`
+    int residual(const vector<int>& open, uint64_t key, int j) {
+        for (size_t p = 0; p < open.size(); p++) {
+            if (open[p] == j) {
+                return static_cast<int>((key >> (4 * p)) & 15);
+            }
+        }
+        return -1;
+    }
+
+    // Assign x (0/1) to the var at position i of a component in state `key`
+    // @return false if that breaks a constraint, else the key of layer i+1
+    bool transition(const Component& comp, int i, uint64_t key, int x, uint64_t& next) {
+        int updated[8];
+        const vector<pair<int, int>>& cons = comp.varCons[i];
+        for (size_t t = 0; t < cons.size(); t++) {
+            int j = cons[t].first;
+            int r = (comp.first[j] == i ? comp.target[j] : residual(comp.open[i], key, j)) - x;
+            if (r < 0 || r > cons[t].second) {
+                return false;
+            }
+            updated[t] = r;
+        }
+        next = 0;
+        const vector<int>& open = comp.open[i + 1];
+        for (size_t p = 0; p < open.size(); p++) {
+            int r = -1;
+            for (size_t t = 0; t < cons.size() && r < 0; t++) {
+                if (cons[t].first == open[p]) {
+                    r = updated[t];
+                }
+            }
+            if (r < 0) {
+                r = residual(comp.open[i], key, open[p]);
+            }
+            next |= static_cast<uint64_t>(r) << (4 * p);
+        }
+        return true;
+    }
+
+    // Order the vars, build the layer tables and run the forward pass
+    // @return false if the component is too big for an exact answer
+    bool enumerate(Component& comp, Frontier& f, size_t stateLimit, Clock::time_point deadline) {
+        size_t n = comp.vars.size();
+        if (n > MAX_COMPONENT) {
+            return false;
+        }
+
+        // BFS order from a var with the fewest constraints keeps few constraints open
+        int start = comp.vars[0];
+        for (int v : comp.vars) {
+            f.position[v] = -1;
+            if (f.varConstraints[v].size() < f.varConstraints[start].size()) {
+                start = v;
+            }
+        }
+        vector<int> order;
+        order.reserve(n);
+        order.push_back(start);
+        f.position[start] = 0;
+        for (size_t head = 0; head < order.size(); head++) {
+            for (int c : f.varConstraints[order[head]]) {
+                const FrontierConstraint& fc = f.constraints[c];
+                for (int k = 0; k < fc.size; k++) {
+                    if (f.position[fc.vars[k]] < 0) {
+                        f.position[fc.vars[k]] = static_cast<int>(order.size());
+                        order.push_back(fc.vars[k]);
+                    }
+                }
+            }
+        }
+        comp.vars = order;
+
+        size_t m = comp.constraints.size();
+        comp.first.assign(m, static_cast<int>(n));
+        comp.last.assign(m, -1);
+        comp.target.assign(m, 0);
+        for (size_t j = 0; j < m; j++) {
+            const FrontierConstraint& fc = f.constraints[comp.constraints[j]];
+            f.localId[comp.constraints[j]] = static_cast<int>(j);
+            comp.target[j] = fc.target;
+            for (int k = 0; k < fc.size; k++) {
+                comp.first[j] = min(comp.first[j], f.position[fc.vars[k]]);
+                comp.last[j] = max(comp.last[j], f.position[fc.vars[k]]);
+            }
+        }
+        comp.varCons.assign(n, {});
+        for (size_t i = 0; i < n; i++) {
+            for (int c : f.varConstraints[comp.vars[i]]) {
+                const FrontierConstraint& fc = f.constraints[c];
+                int left = 0;
+                for (int k = 0; k < fc.size; k++) {
+                    left += f.position[fc.vars[k]] > static_cast<int>(i);
+                }
+                comp.varCons[i].push_back({f.localId[c], left});
+            }
+        }
+
+        // Layer i sits between var i-1 and var i; a constraint is open there
+        // when it has vars on both sides
+        comp.open.assign(n + 1, {});
+        for (size_t i = 1; i <= n; i++) {
+            for (int j : comp.open[i - 1]) {
+                if (comp.last[j] >= static_cast<int>(i)) {
+                    comp.open[i].push_back(j);
+                }
+            }
+            for (const pair<int, int>& con : comp.varCons[i - 1]) {
+                int j = con.first;
+                if (comp.first[j] == static_cast<int>(i - 1) && comp.last[j] >= static_cast<int>(i)) {
+                    comp.open[i].push_back(j);
+                }
+            }
+            if (comp.open[i].size() > MAX_OPEN) {
+                return false;
+            }
+        }
+
+        comp.keys.assign(n + 1, {});
+        comp.successor.assign(n, {});
+        comp.forward.assign(n + 1, {});
+        comp.keys[0].push_back(0);
+        comp.forward[0].push_back(Poly(1, 1.0));
+        unordered_map<uint64_t, int> seen;      // key -> state of the layer being built
+        size_t table = 1;
+        for (size_t i = 0; i < n; i++) {
+            seen.clear();
+            comp.successor[i].assign(comp.keys[i].size(), {{-1, -1}});
+            for (size_t s = 0; s < comp.keys[i].size(); s++) {
+                for (int x = 0; x <= 1; x++) {
+                    uint64_t next;
+                    if (!transition(comp, static_cast<int>(i), comp.keys[i][s], x, next)) {
+                        continue;
+                    }
+                    auto found = seen.find(next);
+                    int id;
+                    if (found == seen.end()) {
+                        id = static_cast<int>(comp.keys[i + 1].size());
+                        seen[next] = id;
+                        comp.keys[i + 1].push_back(next);
+                        comp.forward[i + 1].push_back(Poly(i + 2, 0.0));
+                    } else {
+                        id = found->second;
+                    }
+                    comp.successor[i][s][x] = id;
+                    const Poly& from = comp.forward[i][s];
+                    Poly& to = comp.forward[i + 1][id];
+                    for (size_t k = 0; k < from.size(); k++) {
+                        to[k + x] += from[k];
+                    }
+                }
+            }
+            table += comp.keys[i + 1].size() * (i + 2);
+            if (comp.keys[i + 1].size() > stateLimit || table > MAX_TABLE || Clock::now() > deadline) {
+                return false;
+            }
+        }
+
+        comp.weight = comp.keys[n].empty() ? Poly(n + 1, 0.0) : comp.forward[n][0];
+        return true;
+    }
+
+    // Backward pass: P(var is a mine) from the forward tables and comp.others
+    // @return false if the time budget ran out
+    bool marginals(Component& comp, Clock::time_point deadline) {
+        size_t n = comp.vars.size();
+        vector<double> mineMass(n, 0.0);
+        // after[s][a]: weight of completing state s of layer i+1 when the vars
+        // before it hold a mines (index 0..i+1)
+        vector<Poly> after(comp.keys[n].size(), comp.others);
+        for (size_t i = n; i-- > 0;) {
+            vector<Poly> here(comp.keys[i].size(), Poly(i + 1, 0.0));
+            for (size_t s = 0; s < comp.keys[i].size(); s++) {
+                for (int x = 0; x <= 1; x++) {
+                    int next = comp.successor[i][s][x];
+                    if (next < 0) {
+                        continue;
+                    }
+                    const Poly& b = after[next];
+                    const Poly& fwd = comp.forward[i][s];
+                    for (size_t a = 0; a <= i; a++) {
+                        here[s][a] += b[a + x];
+                        if (x == 1) {
+                            mineMass[i] += fwd[a] * b[a + 1];
+                        }
+                    }
+                }
+            }
+            after.swap(here);
+            if (Clock::now() > deadline) {
+                return false;
+            }
+        }
+        double total = after[0][0];
+        comp.probability.assign(n, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            comp.probability[i] = total > 0.0 ? mineMass[i] / total : 0.0;
+        }
+        return true;
+    }
+
+    // Local estimate: mean count/size of the constraints on each var
+    void approximate(Component& comp, const Frontier& f) {
+        comp.exact = false;
+        comp.probability.assign(comp.vars.size(), 0.0);
+        double expected = 0.0;
+        for (size_t i = 0; i < comp.vars.size(); i++) {
+            const vector<int>& cons = f.varConstraints[comp.vars[i]];
+            double sum = 0.0;
+            for (int c : cons) {
+                sum += static_cast<double>(f.constraints[c].target) / f.constraints[c].size;
+            }
+            comp.probability[i] = min(1.0, max(0.0, sum / cons.size()));
+            expected += comp.probability[i];
+        }
+        // Treated as always holding its expected mine count when combining
+        comp.weight.assign(static_cast<size_t>(lround(expected)) + 1, 0.0);
+        comp.weight.back() = 1.0;
+    }
+
+    // Free the DP tables of a finished component
+    void release(Component& comp) {
+        comp.keys = {};
+        comp.successor = {};
+        comp.forward = {};
+        comp.open = {};
+        comp.varCons = {};
+    }
+
+    // Large-frontier approximation: every interior tile is a mine with the
+    // same probability rho, independently, so a component holding k mines is
+    // weighted by (rho / (1 - rho))^k.  rho is the fixed point of "mines left
+    // minus the frontier's expected mines, spread over the interior".  Sets
+    // comp.others of the exact components.
+    // @return rho
+    double independentOdds(vector<Component>& comps, int minesLeft, int interior) {
+        int frontier = 0;
+        for (const Component& comp : comps) {
+            frontier += static_cast<int>(comp.vars.size());
+        }
+        const double tiny = 1e-12;
+        double rho = min(1.0 - tiny, max(tiny, static_cast<double>(minesLeft) / max(1, interior + frontier)));
+        for (int iteration = 0; iteration < 50 && interior > 0; iteration++) {
+            double logOdds = log(rho / (1.0 - rho));
+            double expected = 0.0;
+            for (const Component& comp : comps) {
+                if (!comp.exact) {
+                    expected += comp.weight.size() - 1;     // the estimate's fixed count
+                    continue;
+                }
+                // Mean of k under weight[k] * odds^k, scaled to avoid overflow
+                double top = -HUGE_VAL;
+                for (size_t k = 0; k < comp.weight.size(); k++) {
+                    if (comp.weight[k] > 0.0) {
+                        top = max(top, log(comp.weight[k]) + k * logOdds);
+                    }
+                }
+                double sum = 0.0;
+                double mean = 0.0;
+                for (size_t k = 0; k < comp.weight.size(); k++) {
+                    if (comp.weight[k] > 0.0) {
+                        double w = exp(log(comp.weight[k]) + k * logOdds - top);
+                        sum += w;
+                        mean += w * k;
+                    }
+                }
+                expected += sum > 0.0 ? mean / sum : 0.0;
+            }
+            double next = min(1.0 - tiny, max(tiny, (minesLeft - expected) / interior));
+            bool settled = fabs(next - rho) < 1e-12;
+            rho = next;
+            if (settled) {
+                break;
+            }
+        }
+        // With no interior the total mine count is not modeled at all
+        double logOdds = interior > 0 ? log(rho / (1.0 - rho)) : 0.0;
+        for (Component& comp : comps) {
+            if (!comp.exact) {
+                continue;
+            }
+            size_t n = comp.weight.size();
+            comp.others.assign(n, 0.0);
+            double top = logOdds > 0.0 ? (n - 1) * logOdds : 0.0;
+            for (size_t k = 0; k < n; k++) {
+                comp.others[k] = exp(k * logOdds - top);
+            }
+        }
+        return interior > 0 ? rho : 0.0;
+    }
+}
+
+ProbabilityEngine::ProbabilityEngine(ThreadPool* pool) : pool(pool) {}
+
+void ProbabilityEngine::setTimeBudget(double seconds) {
+    this->timeBudget = seconds;
+}
+
+void ProbabilityEngine::setStateLimit(size_t states) {
+    this->stateLimit = states;
+}
+
+int ProbabilityEngine::compute(Board& board, MineProbabilities& out) {
+    Clock::time_point deadline = Clock::now() +
+        chrono::duration_cast<Clock::duration>(chrono::duration<double>(this->timeBudget));
+    int rows = board.getRows();
+    int columns = board.getColumns();
+    int cells = rows * columns;
+    out.rows = rows;
+    out.columns = columns;
+    out.mine.assign(cells, 0.0);
+    out.exact = true;
+
+    // --- Player view: known mines, frontier vars and their constraints ---
+    Frontier f;
+    vector<int> varOf(cells, -1);
+    int knownMines = 0;
+    bool contradiction = false;
+    for (int r = 0; r < rows; r++) {
+        const Tile* line = board.getTile(r, 0);
+        for (int c = 0; c < columns; c++) {
+            if (line[c].state == FLAGGED || line[c].state == EXPLODED) {
+                knownMines++;
+                out.mine[r * columns + c] = 1.0;
+            }
+        }
+    }
+    for (int r = 0; r < rows; r++) {
+        const Tile* line = board.getTile(r, 0);
+        for (int c = 0; c < columns; c++) {
+            const Tile& t = line[c];
+            if (t.state != REVEALED || t.adjacentMines == 0) {
+                continue;
+            }
+            FrontierConstraint fc;
+            fc.target = t.adjacentMines;
+            fc.size = 0;
+            for (int nr = max(0, r - 1); nr <= min(rows - 1, r + 1); nr++) {
+                const Tile* near = board.getTile(nr, 0);
+                for (int nc = max(0, c - 1); nc <= min(columns - 1, c + 1); nc++) {
+                    if (nr == r && nc == c) {
+                        continue;
+                    }
+                    TileState state = near[nc].state;
+                    int i = nr * columns + nc;
+                    if (state == FLAGGED || state == EXPLODED) {
+                        fc.target--;
+                    } else if (state == COVERED || state == QUESTIONED) {
+                        if (varOf[i] < 0) {
+                            varOf[i] = static_cast<int>(f.tileOf.size());
+                            f.tileOf.push_back(i);
+                            f.varConstraints.push_back({});
+                        }
+                        fc.vars[fc.size++] = varOf[i];
+                    }
+                }
+            }
+            if (fc.target < 0 || fc.target > fc.size) {
+                contradiction = true;
+            }
+            if (fc.size == 0) {
+                continue;
+            }
+            for (int k = 0; k < fc.size; k++) {
+                f.varConstraints[fc.vars[k]].push_back(static_cast<int>(f.constraints.size()));
+            }
+            f.constraints.push_back(fc);
+        }
+    }
+    size_t varCount = f.tileOf.size();
+    f.position.assign(varCount, -1);
+    f.localId.assign(f.constraints.size(), -1);
+
+    // --- Independent components (union-find over shared constraints) ---
+    vector<int> parent(varCount);
+    for (size_t v = 0; v < varCount; v++) {
+        parent[v] = static_cast<int>(v);
+    }
+    function<int(int)> root = [&parent](int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    for (const FrontierConstraint& fc : f.constraints) {
+        for (int k = 1; k < fc.size; k++) {
+            parent[root(fc.vars[k])] = root(fc.vars[0]);
+        }
+    }
+    vector<Component> comps;
+    vector<int> compOf(varCount, -1);
+    for (size_t v = 0; v < varCount; v++) {
+        int top = root(static_cast<int>(v));
+        if (compOf[top] < 0) {
+            compOf[top] = static_cast<int>(comps.size());
+            comps.push_back(Component());
+        }
+        comps[compOf[top]].vars.push_back(static_cast<int>(v));
+    }
+    for (size_t c = 0; c < f.constraints.size(); c++) {
+        comps[compOf[root(f.constraints[c].vars[0])]].constraints.push_back(static_cast<int>(c));
+    }
+    // Biggest first, so one large component does not start last
+    sort(comps.begin(), comps.end(), [](const Component& a, const Component& b) {
+        return a.vars.size() > b.vars.size();
+    });
+    out.components = static_cast<int>(comps.size());
+
+    int interior = 0;
+    for (int r = 0; r < rows; r++) {
+        const Tile* line = board.getTile(r, 0);
+        for (int c = 0; c < columns; c++) {
+            interior += (line[c].state == COVERED || line[c].state == QUESTIONED) && varOf[r * columns + c] < 0;
+        }
+    }
+    int minesLeft = board.getMines() - knownMines;
+
+    // --- Enumerate every component ---
+    size_t limit = this->stateLimit;
+    parallelFor(this->pool, comps.size(), [&comps, &f, limit, deadline](size_t c) {
+        comps[c].exact = enumerate(comps[c], f, limit, deadline);
+        if (!comps[c].exact) {
+            release(comps[c]);
+            approximate(comps[c], f);
+        }
+    });
+    bool allExact = true;
+    for (Component& comp : comps) {
+        allExact = allExact && comp.exact;
+        if (comp.exact && *max_element(comp.weight.begin(), comp.weight.end()) == 0.0) {
+            contradiction = true;       // no layout satisfies this component
+        }
+        normalize(comp.weight);
+    }
+
+    // --- Combine: weight of K frontier mines is T[K] * C(interior, minesLeft - K) ---
+    size_t frontierMax = 1;
+    for (const Component& comp : comps) {
+        frontierMax += comp.weight.size() - 1;
+    }
+    vector<double> interiorWeight(frontierMax, 0.0);
+    double logBase = -HUGE_VAL;
+    for (size_t k = 0; k < frontierMax; k++) {
+        int left = minesLeft - static_cast<int>(k);
+        if (left >= 0 && left <= interior) {
+            interiorWeight[k] = logGamma(interior + 1.0) - logGamma(left + 1.0) - logGamma(interior - left + 1.0);
+            logBase = max(logBase, interiorWeight[k]);
+        } else {
+            interiorWeight[k] = -HUGE_VAL;
+        }
+    }
+    for (double& w : interiorWeight) {
+        w = w == -HUGE_VAL ? 0.0 : exp(w - logBase);
+    }
+
+    size_t count = comps.size();
+    bool combined = !contradiction;
+    double interiorProbability = 0.0;
+    // The exact combination costs about count * frontier^2; past that, the
+    // components are treated as independent at a common interior density
+    bool independent = static_cast<double>(count) * frontierMax * frontierMax > MAX_COMBINE;
+    if (combined && independent) {
+        interiorProbability = independentOdds(comps, minesLeft, interior);
+    } else if (combined) {
+        vector<Poly> prefix(count + 1, Poly(1, 1.0));
+        vector<Poly> suffix(count + 1, Poly(1, 1.0));
+        for (size_t c = 0; c < count && combined; c++) {
+            prefix[c + 1] = convolve(prefix[c], comps[c].weight);
+            normalize(prefix[c + 1]);
+            suffix[count - 1 - c] = convolve(comps[count - 1 - c].weight, suffix[count - c]);
+            normalize(suffix[count - 1 - c]);
+            combined = Clock::now() <= deadline;
+        }
+        double total = 0.0;
+        double interiorMines = 0.0;
+        if (combined) {
+            const Poly& all = prefix[count];
+            for (size_t k = 0; k < all.size(); k++) {
+                total += all[k] * interiorWeight[k];
+                interiorMines += all[k] * interiorWeight[k] * (minesLeft - static_cast<int>(k));
+            }
+            if (total <= 0.0) {
+                contradiction = contradiction || allExact;
+                combined = false;
+            }
+        }
+        if (combined) {
+            interiorProbability = interior > 0 ? interiorMines / total / interior : 0.0;
+            for (size_t c = 0; c < count && combined; c++) {
+                if (!comps[c].exact) {
+                    continue;
+                }
+                Poly rest = convolve(prefix[c], suffix[c + 1]);
+                comps[c].others.assign(comps[c].weight.size(), 0.0);
+                for (size_t k = 0; k < comps[c].others.size(); k++) {
+                    for (size_t j = 0; j < rest.size(); j++) {
+                        comps[c].others[k] += rest[j] * interiorWeight[k + j];
+                    }
+                }
+                combined = Clock::now() <= deadline;
+            }
+        }
+    }
+    parallelFor(this->pool, count, [&comps, &f, combined, deadline](size_t c) {
+        if (comps[c].exact && !(combined && marginals(comps[c], deadline))) {
+            approximate(comps[c], f);
+        }
+        release(comps[c]);
+    });
+    if (!combined) {
+        // Nothing exact survives: spread what the frontier estimate leaves over the interior
+        double frontierMines = 0.0;
+        for (const Component& comp : comps) {
+            for (double p : comp.probability) {
+                frontierMines += p;
+            }
+        }
+        interiorProbability = interior > 0 ? min(1.0, max(0.0, (minesLeft - frontierMines) / interior)) : 0.0;
+    }
+
+    // --- Write out ---
+    for (const Component& comp : comps) {
+        out.exact = out.exact && comp.exact;
+        for (size_t i = 0; i < comp.vars.size(); i++) {
+            out.mine[f.tileOf[comp.vars[i]]] = comp.probability[i];
+        }
+    }
+    out.exact = out.exact && combined && !independent;
+    for (int r = 0; r < rows; r++) {
+        const Tile* line = board.getTile(r, 0);
+        for (int c = 0; c < columns; c++) {
+            if ((line[c].state == COVERED || line[c].state == QUESTIONED) && varOf[r * columns + c] < 0) {
+                out.mine[r * columns + c] = interiorProbability;
+            }
+        }
+    }
+    return contradiction ? -1 : 0;
+}
@@ -0,0 +1,62 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ *
+ * minesweeper_server: headless game server for bot clients.
+ *
+ * Run:
+ *   ./minesweeper_server [--threads T] [--save-dir DIR]                (requests on stdin, replies on stdout)
+ *   ./minesweeper_server --socket PATH [--threads T] [--save-dir DIR]  (any number of clients on a Unix socket)
+ *
+ * One request per line, one reply line per request; see game_server.hpp for
+ * the protocol.  SAVE/LOAD are refused unless --save-dir names the one
+ * directory they may use.  Example:
+ *
+ *   NEW g1 16 30 99 42
+ *   REVEAL g1 8 15
+ *   DIFF g1 play 37 245R0 246R1 ...
+ *
+ * On exit the per-request latency (read to reply written) goes to stderr.
+ */
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include "minesweeper/game_server.hpp"
+using namespace std;
+
+static void usage(const char* argv0){
+    fprintf(stderr,"usage: %s [--socket PATH] [--threads T] [--save-dir DIR]\n",argv0);
+}
+
+int main(int argc,char** argv){
+    string socket_path, save_dir;
+    unsigned threads=0;               // 0 = one per hardware thread
+
+    for(int i=1;i<argc;++i){
+        const char* a=argv[i];
+        if(i+1>=argc){ usage(argv[0]); return 2; }
+        const char* v=argv[++i];
+        if(!strcmp(a,"--socket")) socket_path=v;
+        else if(!strcmp(a,"--save-dir")) save_dir=v;
+        else if(!strcmp(a,"--threads")) threads=(unsigned)max(0,atoi(v));
+        else { usage(argv[0]); return 2; }
+    }
+
+    // A client hanging up mid-reply must not kill the server
+    signal(SIGPIPE,SIG_IGN);
+
+    GameServer server(threads,save_dir);
+    int rc=socket_path.empty() ? server.serve(STDIN_FILENO,STDOUT_FILENO) : server.serveSocket(socket_path);
+    if(rc!=0) fprintf(stderr,"%s: %s\n",argv[0],socket_path.empty() ? "I/O error" : ("cannot listen on "+socket_path).c_str());
+
+    const LatencyHistogram& lat=server.latency();
+    fprintf(stderr,"requests %llu, latency p50 %.1f us, p99 %.1f us, max %.1f us\n",
+            (unsigned long long)lat.count(),lat.percentile(50)/1e3,lat.percentile(99)/1e3,lat.max()/1e3);
+    return rc==0?0:1;
+}
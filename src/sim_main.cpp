@@ -0,0 +1,119 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ *
+ * minesweeper_sim: headless batch playouts for difficulty tuning.
+ *
+ * Run:
+ *   ./minesweeper_sim [--rows R] [--cols C] [--mines M] [--games N]
+ *                     [--threads T] [--seed S] [--strategy random|solver|probability]
+ *
+ * Reports games/sec, win rate and the distribution of reveals per game.
+ * The totals depend only on the seed, not on --threads.
+ *
+ *   ./minesweeper_sim --no-guess [--rows R] [--cols C] [--mines M] [--games N] ...
+ *
+ * Generates N no-guess boards (first click in the middle) instead, each one
+ * searched in parallel across the threads, and reports boards/sec.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <chrono>
+#include "minesweeper/no_guess_generator.hpp"
+#include "minesweeper/simulation.hpp"
+#include "minesweeper/thread_pool.hpp"
+using namespace std;
+
+static map<string, StrategyFactory> strategies(){
+    return {
+        {"random", []{ return unique_ptr<Strategy>(new RandomStrategy()); }},
+        {"solver", []{ return unique_ptr<Strategy>(new SolverStrategy()); }},
+        {"probability", []{ return unique_ptr<Strategy>(new ProbabilityStrategy()); }},
+    };
+}
+
+static void usage(const char* argv0){
+    fprintf(stderr,"usage: %s [--rows R] [--cols C] [--mines M] [--games N] [--threads T] [--seed S] [--strategy NAME] [--no-guess]\n",argv0);
+    fprintf(stderr,"strategies:");
+    for(auto& s : strategies()) fprintf(stderr," %s",s.first.c_str());
+    fprintf(stderr,"\n");
+}
+
+// Tracked metric: no-guess boards generated per second
+static int generate_boards(const SimulationConfig& cfg,ThreadPool& pool){
+    NoGuessGenerator gen(&pool);
+    Cell click={cfg.rows/2,cfg.columns/2};
+    vector<Cell> mines;
+    uint64_t made=0,attempts=0;
+    auto t0=chrono::steady_clock::now();
+    for(uint64_t g=0;g<cfg.games;++g){
+        if(gen.generate(cfg.rows,cfg.columns,cfg.mines,click,Simulator::gameSeed(cfg.seed,g),mines)==0) ++made;
+        attempts+=gen.attempts();
+    }
+    double secs=chrono::duration<double>(chrono::steady_clock::now()-t0).count();
+    printf("board      %dx%d, %d mines, first click (%d,%d)\n",cfg.rows,cfg.columns,cfg.mines,click.row,click.col);
+    printf("generator  no-guess, %zu threads, seed %llu\n",pool.size(),(unsigned long long)cfg.seed);
+    printf("boards     %llu of %llu in %.3f s (%.1f boards/s)\n",(unsigned long long)made,(unsigned long long)cfg.games,secs,secs>0?made/secs:0.0);
+    printf("attempts   %.1f candidate layouts per request\n",cfg.games?(double)attempts/cfg.games:0.0);
+    return made==cfg.games?0:1;
+}
+
+int main(int argc,char** argv){
+    SimulationConfig cfg;
+    unsigned threads=0;               // 0 = one per hardware thread
+    string strategy="random";
+    bool no_guess=false;
+
+    for(int i=1;i<argc;++i){
+        const char* a=argv[i];
+        if(!strcmp(a,"--no-guess")){ no_guess=true; continue; }
+        if(i+1>=argc){ usage(argv[0]); return 2; }
+        const char* v=argv[++i];
+        if(!strcmp(a,"--rows")) cfg.rows=max(1,atoi(v));
+        else if(!strcmp(a,"--cols")) cfg.columns=max(1,atoi(v));
+        else if(!strcmp(a,"--mines")) cfg.mines=max(0,atoi(v));
+        else if(!strcmp(a,"--games")) cfg.games=strtoull(v,nullptr,10);
+        else if(!strcmp(a,"--threads")) threads=(unsigned)strtoul(v,nullptr,10);
+        else if(!strcmp(a,"--seed")) cfg.seed=strtoull(v,nullptr,10);
+        else if(!strcmp(a,"--strategy")) strategy=v;
+        else { usage(argv[0]); return 2; }
+    }
+    cfg.mines=min(cfg.mines, cfg.rows*cfg.columns-1);
+
+    auto all=strategies();
+    auto it=all.find(strategy);
+    if(it==all.end()){ usage(argv[0]); return 2; }
+
+    ThreadPool pool(threads);
+    if(no_guess) return generate_boards(cfg,pool);
+    Simulator sim(cfg, it->second);
+    SimulationResult res=sim.run(pool);
+
+    printf("board      %dx%d, %d mines\n",cfg.rows,cfg.columns,cfg.mines);
+    printf("strategy   %s, %zu threads, seed %llu\n",strategy.c_str(),pool.size(),(unsigned long long)cfg.seed);
+    printf("games      %llu in %.3f s (%.0f games/s)\n",(unsigned long long)res.games,res.seconds,res.gamesPerSecond());
+    printf("win rate   %.2f%% (%llu won, %llu lost, %llu resigned)\n",100.0*res.winRate(),
+           (unsigned long long)res.wins,(unsigned long long)res.losses,(unsigned long long)res.resigned);
+    printf("reveals    p10 %d  p50 %d  p90 %d  p99 %d  max %d\n",
+           res.revealPercentile(0.10),res.revealPercentile(0.50),res.revealPercentile(0.90),
+           res.revealPercentile(0.99),res.revealPercentile(1.0));
+
+    // Histogram in (at most) 16 equal-width buckets
+    int top=(int)res.revealHistogram.size();
+    int width=max(1,(top+15)/16);
+    uint64_t peak=1;
+    vector<uint64_t> buckets((top+width-1)/width,0);
+    for(int n=0;n<top;++n) buckets[n/width]+=res.revealHistogram[n];
+    for(uint64_t b : buckets) peak=max(peak,b);
+    for(size_t b=0;b<buckets.size();++b){
+        int bar=(int)(40*buckets[b]/peak);
+        printf("  %5d-%-5d %10llu %s\n",(int)b*width,(int)(b+1)*width-1,(unsigned long long)buckets[b],string(bar,'#').c_str());
+    }
+    return 0;
+}
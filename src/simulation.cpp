@@ -0,0 +1,249 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <numeric>
+#include "minesweeper/simulation.hpp"
+
+using namespace std;
+
+namespace {
+    // Games a worker claims from the shared counter at a time
+    const uint64_t GAME_BATCH = 16;
+
+    // SplitMix64 finalizer: a cheap, well-mixed 64-bit hash
+    uint64_t mix64(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Pick a uniformly random tile satisfying `wanted`.  Rejection sampling
+    // stays cheap until few tiles qualify; then a scan from a random start
+    // takes over so the search always terminates.
+    template <typename Pred>
+    bool pickRandom(Board& board, std::mt19937_64& rng, Pred wanted, Cell& cell) {
+        int columns = board.getColumns();
+        int cells = board.getRows() * columns;
+        uniform_int_distribution<int> pick(0, cells - 1);
+        for (int tries = 0; tries < 64; tries++) {
+            int i = pick(rng);
+            if (wanted(i / columns, i % columns)) {
+                cell = {i / columns, i % columns};
+                return true;
+            }
+        }
+        int start = pick(rng);
+        for (int k = 0; k < cells; k++) {
+            int i = (start + k) % cells;
+            if (wanted(i / columns, i % columns)) {
+                cell = {i / columns, i % columns};
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // One worker's tallies on its own cache line (they are updated every game)
+    struct alignas(64) WorkerResult {
+        SimulationResult result;
+    };
+}
+
+void RandomStrategy::start(Board& /*board*/, uint64_t seed) {
+    this->rng.seed(seed);
+}
+
+bool RandomStrategy::nextMove(Board& board, Move& move) {
+    Cell cell;
+    if (!pickRandom(board, this->rng, [&board](int r, int c) {
+            return board.getTile(r, c)->state == COVERED;
+        }, cell)) {
+        return false;
+    }
+    move = {MOVE_REVEAL, cell.row, cell.col};
+    return true;
+}
+
+void SolverStrategy::start(Board& board, uint64_t seed) {
+    this->rng.seed(seed);
+    this->guessOrder.resize(board.getRows() * board.getColumns());
+    iota(this->guessOrder.begin(), this->guessOrder.end(), 0);
+    shuffle(this->guessOrder.begin(), this->guessOrder.end(), this->rng);
+    this->guessNext = 0;
+    if (this->bound != &board) {
+        this->solver.reset(new Solver(board));
+        this->bound = &board;
+    } else {
+        this->solver->reset();      // reuses the buffers of the previous game
+    }
+}
+
+bool SolverStrategy::nextMove(Board& board, Move& move) {
+    Cell cell;
+    this->solver->solve();
+    if (!this->solver->nextSafe(cell) && !guess(board, cell)) {
+        return false;
+    }
+    move = {MOVE_REVEAL, cell.row, cell.col};
+    return true;
+}
+
+bool SolverStrategy::guess(Board& board, Cell& cell) {
+    // Tiles only ever leave the unknown set within a game, so anything
+    // skipped here never needs to be looked at again
+    int columns = board.getColumns();
+    while (this->guessNext < this->guessOrder.size()) {
+        int i = this->guessOrder[this->guessNext++];
+        cell = {i / columns, i % columns};
+        if (board.getTile(cell.row, cell.col)->state == COVERED &&
+            this->solver->deduction(cell.row, cell.col) == DEDUCED_UNKNOWN) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ProbabilityStrategy::guess(Board& board, Cell& cell) {
+    this->engine.compute(board, this->probabilities);
+    int columns = board.getColumns();
+    double best = 2.0;
+    for (int i : this->guessOrder) {
+        if (board.getTile(i / columns, i % columns)->state == COVERED && this->probabilities.mine[i] < best) {
+            best = this->probabilities.mine[i];
+            cell = {i / columns, i % columns};
+        }
+    }
+    return best <= 1.0;
+}
+
+void SolverStrategy::observe(Board& /*board*/, const vector<Cell>& changed) {
+    this->solver->update(changed);
+}
+
+double SimulationResult::gamesPerSecond() const {
+    return this->seconds > 0.0 ? this->games / this->seconds : 0.0;
+}
+
+double SimulationResult::winRate() const {
+    return this->games > 0 ? static_cast<double>(this->wins) / this->games : 0.0;
+}
+
+int SimulationResult::revealPercentile(double q) const {
+    uint64_t target = static_cast<uint64_t>(q * this->games);
+    uint64_t seen = 0;
+    for (size_t n = 0; n < this->revealHistogram.size(); n++) {
+        seen += this->revealHistogram[n];
+        if (seen > 0 && seen >= target) {
+            return static_cast<int>(n);
+        }
+    }
+    return 0;
+}
+
+void SimulationResult::merge(const SimulationResult& other) {
+    this->games += other.games;
+    this->wins += other.wins;
+    this->losses += other.losses;
+    this->resigned += other.resigned;
+    if (this->revealHistogram.size() < other.revealHistogram.size()) {
+        this->revealHistogram.resize(other.revealHistogram.size(), 0);
+    }
+    for (size_t n = 0; n < other.revealHistogram.size(); n++) {
+        this->revealHistogram[n] += other.revealHistogram[n];
+    }
+}
+
+Simulator::Simulator(SimulationConfig config, StrategyFactory factory) :
+    config(config), factory(move(factory)) {
+    assert(config.rows > 0 && config.columns > 0 && "Simulator: empty board");
+    assert(config.mines < config.rows * config.columns && "Simulator: no safe tile");
+}
+
+uint64_t Simulator::gameSeed(uint64_t seed, uint64_t game) {
+    return mix64(seed ^ mix64(game));
+}
+
+int Simulator::playGame(Board& board, Strategy& strategy, uint64_t seed,
+                        SimulationResult& outcome) {
+    // Every move changes at least one tile state, and a tile can be toggled
+    // through its three states, so a sane strategy never needs more than this.
+    int moveLimit = 4 * board.getRows() * board.getColumns();
+    int reveals = 0;
+    vector<Cell> changed;
+    strategy.start(board, seed);
+    for (int moves = 0; moves < moveLimit && !board.isLost() && !board.isWon(); moves++) {
+        Move next;
+        if (!strategy.nextMove(board, next)) {
+            break;
+        }
+        changed.clear();
+        if (next.type == MOVE_REVEAL) {
+            board.revealTile(next.row, next.col, changed);
+            reveals++;
+        } else if (next.type == MOVE_CHORD) {
+            board.chordTile(next.row, next.col, changed);
+            reveals++;
+        } else {
+            board.toggleTile(next.row, next.col);
+            changed.push_back({next.row, next.col});
+        }
+        strategy.observe(board, changed);
+    }
+
+    outcome.games++;
+    if (board.isWon()) {
+        outcome.wins++;
+    } else if (board.isLost()) {
+        outcome.losses++;
+    } else {
+        outcome.resigned++;
+    }
+    if (outcome.revealHistogram.size() <= static_cast<size_t>(reveals)) {
+        outcome.revealHistogram.resize(reveals + 1, 0);
+    }
+    outcome.revealHistogram[reveals]++;
+    return reveals;
+}
+
+SimulationResult Simulator::run(ThreadPool& pool) {
+    auto started = chrono::steady_clock::now();
+    atomic<uint64_t> nextGame(0);
+    size_t workers = pool.size();
+    vector<WorkerResult> partial(workers);
+
+    // parallelFor waits only for these workers, so run() may be called from a pool task
+    pool.parallelFor(workers, [this, &nextGame, &partial](size_t w) {
+        const SimulationConfig& cfg = this->config;
+        unique_ptr<Strategy> strategy = this->factory();
+        Board board(cfg.rows, cfg.columns, cfg.mines, uint64_t{0});
+        SimulationResult& mine = partial[w].result;
+        while (true) {
+            uint64_t first = nextGame.fetch_add(GAME_BATCH, memory_order_relaxed);
+            if (first >= cfg.games) {
+                break;
+            }
+            uint64_t last = min(first + GAME_BATCH, cfg.games);
+            for (uint64_t g = first; g < last; g++) {
+                uint64_t seed = gameSeed(cfg.seed, g);
+                board.reset(cfg.rows, cfg.columns, cfg.mines, seed);
+                playGame(board, *strategy, mix64(seed), mine);
+            }
+        }
+    });
+
+    SimulationResult total;
+    for (const WorkerResult& part : partial) {
+        total.merge(part.result);
+    }
+    total.seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    return total;
+}
@@ -0,0 +1,223 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <algorithm>
+#include "minesweeper/solver.hpp"
+
+using namespace std;
+
+namespace {
+    bool contains(const int* cells, int size, int cell) {
+        return find(cells, cells + size, cell) != cells + size;
+    }
+}
+
+Solver::Solver(Board& board) : board(board) {
+    reset();
+}
+
+void Solver::reset() {
+    this->rows = this->board.getRows();
+    this->columns = this->board.getColumns();
+    int cells = this->rows * this->columns;
+    this->deduced.assign(cells, DEDUCED_UNKNOWN);
+    this->queued.assign(cells, 0);
+    this->worklist.clear();
+    this->safeFound.clear();
+    this->safeNext = 0;
+    this->mineFound.clear();
+    for (int i = 0; i < cells; i++) {
+        enqueue(i);
+    }
+}
+
+void Solver::update(const vector<Cell>& changed) {
+    for (const Cell& cell : changed) {
+        update(cell.row, cell.col);
+    }
+}
+
+void Solver::update(int row, int col) {
+    int i = row * this->columns + col;
+    enqueue(i);
+    touch(i);
+}
+
+void Solver::solve() {
+    while (!this->worklist.empty()) {
+        int i = this->worklist.back();
+        this->worklist.pop_back();
+        this->queued[i] = 0;
+        process(i);
+    }
+}
+
+Deduction Solver::deduction(int row, int col) const {
+    return static_cast<Deduction>(this->deduced[row * this->columns + col]);
+}
+
+bool Solver::nextSafe(Cell& cell) {
+    while (this->safeNext < this->safeFound.size()) {
+        cell = this->safeFound[this->safeNext++];
+        TileState state = this->board.getTile(cell.row, cell.col)->state;
+        if (state == COVERED || state == QUESTIONED) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const vector<Cell>& Solver::minesFound() const {
+    return this->mineFound;
+}
+
+bool Solver::knownMine(const Tile& t, int i) const {
+    return this->deduced[i] == DEDUCED_MINE || t.state == FLAGGED || t.state == EXPLODED;
+}
+
+bool Solver::unknown(const Tile& t, int i) const {
+    return this->deduced[i] == DEDUCED_UNKNOWN && (t.state == COVERED || t.state == QUESTIONED);
+}
+
+void Solver::gather(int i, Constraint& out) const {
+    int row = i / this->columns;
+    int col = i % this->columns;
+    out.size = 0;
+    out.mines = tile(i).adjacentMines;
+    // Tiles of a row are contiguous, so fetch one row pointer per neighbor row
+    for (int r = max(0, row - 1); r <= min(this->rows - 1, row + 1); r++) {
+        const Tile* line = this->board.getTile(r, 0);
+        for (int c = max(0, col - 1); c <= min(this->columns - 1, col + 1); c++) {
+            int j = r * this->columns + c;
+            if (j == i) {
+                continue;
+            }
+            if (knownMine(line[c], j)) {
+                out.mines--;
+            } else if (unknown(line[c], j)) {
+                out.cells[out.size++] = j;
+            }
+        }
+    }
+}
+
+void Solver::enqueue(const Tile& t, int i) {
+    if (this->queued[i] || t.state != REVEALED || t.adjacentMines == 0) {
+        return;
+    }
+    this->queued[i] = 1;
+    this->worklist.push_back(i);
+}
+
+void Solver::touch(int i) {
+    int row = i / this->columns;
+    int col = i % this->columns;
+    for (int r = max(0, row - 1); r <= min(this->rows - 1, row + 1); r++) {
+        const Tile* line = this->board.getTile(r, 0);
+        for (int c = max(0, col - 1); c <= min(this->columns - 1, col + 1); c++) {
+            if (r != row || c != col) {
+                enqueue(line[c], r * this->columns + c);
+            }
+        }
+    }
+}
+
+void Solver::markSafe(int i) {
+    if (this->deduced[i] != DEDUCED_UNKNOWN) {
+        return;
+    }
+    this->deduced[i] = DEDUCED_SAFE;
+    this->safeFound.push_back({i / this->columns, i % this->columns});
+    touch(i);
+}
+
+void Solver::markMine(int i) {
+    if (this->deduced[i] != DEDUCED_UNKNOWN) {
+        return;
+    }
+    this->deduced[i] = DEDUCED_MINE;
+    this->mineFound.push_back({i / this->columns, i % this->columns});
+    touch(i);
+}
+
+bool Solver::process(int i) {
+    Constraint c;
+    gather(i, c);
+    if (c.size == 0) {
+        return false;
+    }
+
+    // Single-point rules
+    if (c.mines <= 0 || c.mines >= c.size) {
+        for (int k = 0; k < c.size; k++) {
+            if (c.mines <= 0) {
+                markSafe(c.cells[k]);
+            } else {
+                markMine(c.cells[k]);
+            }
+        }
+        return true;
+    }
+
+    // Pair rule against every constraint that can share an unknown tile
+    // (revealed tiles up to two steps away)
+    int row = i / this->columns;
+    int col = i % this->columns;
+    for (int r = max(0, row - 2); r <= min(this->rows - 1, row + 2); r++) {
+        const Tile* line = this->board.getTile(r, 0);
+        for (int cc = max(0, col - 2); cc <= min(this->columns - 1, col + 2); cc++) {
+            int j = r * this->columns + cc;
+            if (j == i || line[cc].state != REVEALED || line[cc].adjacentMines == 0) {
+                continue;
+            }
+            Constraint d;
+            gather(j, d);
+            int shared = 0;
+            for (int k = 0; k < d.size; k++) {
+                shared += contains(c.cells, c.size, d.cells[k]);
+            }
+            if (shared == 0) {
+                continue;
+            }
+            // Bounds on the mines inside the shared tiles, from both constraints
+            int least = max({0, c.mines - (c.size - shared), d.mines - (d.size - shared)});
+            int most = min({shared, c.mines, d.mines});
+            bool progress = settleDifference(c, d, least, most);
+            progress = settleDifference(d, c, least, most) || progress;
+            if (progress) {
+                return true;    // c changed; markSafe/markMine queued it again
+            }
+        }
+    }
+    return false;
+}
+
+bool Solver::settleDifference(const Constraint& c, const Constraint& other, int leastShared, int mostShared) {
+    int rest[8];
+    int size = 0;
+    for (int k = 0; k < c.size; k++) {
+        if (!contains(other.cells, other.size, c.cells[k])) {
+            rest[size++] = c.cells[k];
+        }
+    }
+    if (size == 0) {
+        return false;
+    }
+    if (c.mines - leastShared <= 0) {
+        for (int k = 0; k < size; k++) {
+            markSafe(rest[k]);
+        }
+        return true;
+    }
+    if (c.mines - mostShared >= size) {
+        for (int k = 0; k < size; k++) {
+            markMine(rest[k]);
+        }
+        return true;
+    }
+    return false;
+}
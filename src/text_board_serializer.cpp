@@ -10,39 +10,11 @@
 #include "minesweeper/board.hpp"
 
 int TextBoardSerializer::save(Board& board, ostream& out) {
-    // Save rows, columns, mines
-    out << board.getRows() << " " << board.getColumns() << " " << board.getMines() << "\n";
-    // Save each tile's state
-    for (int r = 0; r < board.getRows(); r++) {
-        for (int c = 0; c < board.getColumns(); c++) {
-            Tile* tile = board.getTile(r, c);
-            out << static_cast<int>(tile->state) << " " << tile->isMine << " " << tile->adjacentMines << "\n";
-        }
-    }
-    return 0; // success
+    return write(board, out);
 }
 
 int TextBoardSerializer::load(Board& board, istream& in) {
-    int r, c, m;
-    in >> r >> c >> m;
-    if (r <= 0 || c <= 0 || m < 0) {
-        return -1; // invalid dimensions
-    }
-    Tile* tile;
-    board.reset(r, c, m);
-    for (int row = 0; row < board.getRows(); row++) {
-        for (int col = 0; col < board.getColumns(); col++) {
-            int stateInt;
-            bool isMine;
-            unsigned int adjacentMines;
-            in >> stateInt >> isMine >> adjacentMines;
-            tile = board.getTile(row, col);
-            tile->state = intToTileState(stateInt);
-            tile->isMine = isMine;
-            tile->adjacentMines = adjacentMines;
-        }
-    }
-    return 0; // success
+    return read(board, in);
 }
 
 TileState TextBoardSerializer::intToTileState(int value) {
@@ -0,0 +1,102 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <atomic>
+#include <memory>
+#include "minesweeper/thread_pool.hpp"
+
+using namespace std;
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threads; i++) {
+        this->workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(this->lock);
+        this->stopping = true;
+    }
+    this->taskReady.notify_all();
+    for (thread& worker : this->workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> guard(this->lock);
+        this->tasks.push_back(move(task));
+    }
+    this->taskReady.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> guard(this->lock);
+    this->allDone.wait(guard, [this] { return this->tasks.empty() && this->running == 0; });
+}
+
+// Helpers that start after every index is claimed return without touching
+// `body`; the shared state outlives the call for their sake.
+void ThreadPool::parallelFor(size_t count, const function<void(size_t)>& body) {
+    struct Batch {
+        atomic<size_t> next{0};
+        size_t finished = 0;
+        mutex lock;
+        condition_variable done;
+    };
+    auto batch = make_shared<Batch>();
+    auto work = [batch, count, &body] {
+        size_t ran = 0;
+        for (size_t i = batch->next++; i < count; i = batch->next++) {
+            body(i);
+            ran++;
+        }
+        if (ran > 0) {
+            lock_guard<mutex> guard(batch->lock);
+            batch->finished += ran;
+            if (batch->finished == count) {
+                batch->done.notify_all();
+            }
+        }
+    };
+    size_t helpers = count > 1 ? min(this->size(), count - 1) : 0;
+    for (size_t h = 0; h < helpers; h++) {
+        this->submit(work);
+    }
+    work();
+    unique_lock<mutex> guard(batch->lock);
+    batch->done.wait(guard, [&batch, count] { return batch->finished == count; });
+}
+
+size_t ThreadPool::size() const {
+    return this->workers.size();
+}
+
+void ThreadPool::workerLoop() {
+    unique_lock<mutex> guard(this->lock);
+    while (true) {
+        this->taskReady.wait(guard, [this] { return this->stopping || !this->tasks.empty(); });
+        if (this->tasks.empty()) {
+            return; // stopping and drained
+        }
+        function<void()> task = move(this->tasks.front());
+        this->tasks.pop_front();
+        this->running++;
+        guard.unlock();
+        task();
+        guard.lock();
+        this->running--;
+        if (this->tasks.empty() && this->running == 0) {
+            this->allDone.notify_all();
+        }
+    }
+}
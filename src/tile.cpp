@@ -20,7 +20,7 @@ ostream& operator<<(ostream& out, const Tile& tile) {
         out << ".";
         return out;
     }
-    out << tile.adjacentMines;
+    out << static_cast<unsigned int>(tile.adjacentMines);
     return out;
 }
 
@@ -0,0 +1,94 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "minesweeper/tile_storage.hpp"
+
+using namespace std;
+
+// ---------- MappedFile ----------
+
+shared_ptr<MappedFile> MappedFile::open(const string& path, bool shared) {
+    int fd = ::open(path.c_str(), shared ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    void* bytes = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+    if (bytes == MAP_FAILED) {
+        return nullptr;
+    }
+
+    shared_ptr<MappedFile> file(new MappedFile());
+    file->bytes = static_cast<char*>(bytes);
+    file->length = length;
+    file->shared = shared;
+    return file;
+}
+
+MappedFile::~MappedFile() {
+    if (this->bytes) {
+        munmap(this->bytes, this->length);
+    }
+}
+
+int MappedFile::sync() {
+    if (!this->shared) {
+        return 0; // nothing ever reaches the file
+    }
+    return msync(this->bytes, this->length, MS_SYNC) == 0 ? 0 : -1;
+}
+
+// ---------- TileStorage ----------
+
+TileStorage::TileStorage(const TileStorage& other) :
+    owned(other.begin(), other.end()), base(owned.data()), count(other.count) {}
+
+TileStorage& TileStorage::operator=(const TileStorage& other) {
+    if (this != &other) {
+        this->owned.assign(other.begin(), other.end());
+        this->file.reset();
+        this->base = this->owned.data();
+        this->count = other.count;
+    }
+    return *this;
+}
+
+void TileStorage::assign(size_t count, const Tile& tile) {
+    this->owned.assign(count, tile);
+    this->file.reset();
+    this->base = this->owned.data();
+    this->count = count;
+}
+
+void TileStorage::reserve(size_t count) {
+    if (this->file || this->owned.capacity() >= count) {
+        return;
+    }
+    size_t size = this->owned.size();
+    this->owned.resize(count);
+    this->owned.resize(size);
+    this->base = this->owned.data();
+}
+
+void TileStorage::attach(shared_ptr<MappedFile> file, size_t offset, size_t count) {
+    this->owned.clear();
+    this->owned.shrink_to_fit();
+    this->base = reinterpret_cast<Tile*>(file->data() + offset);
+    this->count = count;
+    this->file = move(file);
+}
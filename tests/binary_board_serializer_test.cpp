@@ -0,0 +1,87 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/binary_board_serializer_test.cpp
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include "minesweeper/binary_board_serializer.hpp"
+#include "minesweeper/board.hpp"
+
+namespace {
+    std::shared_ptr<ISerializable> binary() {
+        return std::make_shared<BinaryBoardSerializer>();
+    }
+
+    // Board with a mix of every tile state
+    Board playedBoard() {
+        Board board(20, 33, 60, uint64_t{11}, binary());
+        board.toggleTile(0, 0);
+        board.toggleTile(0, 1);
+        board.toggleTile(0, 1);
+        for (int r = 0; r < board.getRows(); r += 4) {
+            for (int c = 0; c < board.getColumns(); c += 4) {
+                if (!board.getTile(r, c)->isMine) board.revealTile(r, c);
+            }
+        }
+        for (int r = 0; r < board.getRows(); ++r) {
+            if (board.getTile(r, 5)->isMine) { board.revealTile(r, 5); break; }
+        }
+        return board;
+    }
+}
+
+TEST(BinarySerializer_RoundTrip, RestoresEveryTileAndCounters) {
+    Board original = playedBoard();
+    std::stringstream buffer;
+    ASSERT_EQ(original.save(buffer), 0);
+    EXPECT_EQ(buffer.str().size(), 20u + 20u * 33u + 4u);
+
+    Board restored(5, 4, 3, uint64_t{1}, binary());
+    ASSERT_EQ(restored.load(buffer), 0);
+    EXPECT_TRUE(restored == original);
+    EXPECT_EQ(restored.minesRemaining(), original.minesRemaining());
+    EXPECT_EQ(restored.isLost(), original.isLost());
+}
+
+TEST(BinarySerializer_Errors, RejectsBadMagicAndVersion) {
+    Board original = playedBoard();
+    std::stringstream buffer;
+    ASSERT_EQ(original.save(buffer), 0);
+
+    std::string bytes = buffer.str();
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    std::string badVersion = bytes;
+    badVersion[4] = 99;
+
+    for (const std::string& data : {badMagic, badVersion}) {
+        Board restored(5, 4, 3, uint64_t{1}, binary());
+        Board untouched = restored;
+        std::istringstream in(data);
+        EXPECT_EQ(restored.load(in), -1);
+        EXPECT_TRUE(restored == untouched);
+    }
+}
+
+TEST(BinarySerializer_Errors, RejectsCorruptionAndTruncation) {
+    Board original = playedBoard();
+    std::stringstream buffer;
+    ASSERT_EQ(original.save(buffer), 0);
+    std::string bytes = buffer.str();
+
+    std::string flipped = bytes;
+    flipped[40] ^= 0x40;   // inside the tile data
+    std::string truncated = bytes.substr(0, bytes.size() - 10);
+
+    for (const std::string& data : {flipped, truncated, std::string("MSWB")}) {
+        Board restored(5, 4, 3, uint64_t{1}, binary());
+        std::istringstream in(data);
+        EXPECT_EQ(restored.load(in), -1);
+        EXPECT_EQ(restored.getRows(), 5);
+    }
+}
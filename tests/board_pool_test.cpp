@@ -0,0 +1,79 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/board_pool_test.cpp
+#include <gtest/gtest.h>
+#include "minesweeper/board_pool.hpp"
+
+TEST(BoardPool_Acquire, ReusesBoardsOfTheSameSizeClass) {
+    BoardPool pool;
+    Board* first;
+    const Tile* tiles;
+    {
+        BoardPool::Handle board = pool.acquire(16, 30, 99, uint64_t{1});
+        first = board.get();
+        tiles = board->getTile(0, 0);
+    }
+    EXPECT_EQ(pool.idle(), 1u);
+
+    // 16x30 and 20x20 both round up to 512 tiles; 9x9 does not
+    BoardPool::Handle same = pool.acquire(20, 20, 50, uint64_t{2});
+    BoardPool::Handle other = pool.acquire(9, 9, 10, uint64_t{3});
+    EXPECT_EQ(same.get(), first);
+    EXPECT_NE(other.get(), first);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.idle(), 0u);
+    EXPECT_EQ(same->getRows(), 20);
+    EXPECT_EQ(same->getMines(), 50);
+
+    // Shrinking back needs no new tile buffer
+    same->reset(16, 30, 99);
+    EXPECT_EQ(same->getTile(0, 0), tiles);
+}
+
+TEST(BoardPool_Acquire, HandsOutBoardsLikeNewOnes) {
+    BoardPool pool;
+    {
+        BoardPool::Handle board = pool.acquire(9, 9, 10, uint64_t{7});
+        board->setUndoDepth(8);
+        board->setFirstClick(FIRST_CLICK_OPENING);
+        board->revealTile(4, 4);
+    }
+    BoardPool::Handle board = pool.acquire(9, 9, 10, uint64_t{7});
+    EXPECT_TRUE(*board == Board(9, 9, 10, uint64_t{7}));
+    EXPECT_EQ(board->getFirstClick(), FIRST_CLICK_ANY);
+    board->revealTile(0, 0);
+    EXPECT_FALSE(board->undo());
+}
+
+TEST(BoardPool_Reserve, KeepsWarmBoardsIdle) {
+    BoardPool pool;
+    pool.reserve(16, 30, 3);
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool.idle(), 3u);
+
+    BoardPool::Handle a = pool.acquire(16, 30, 99);
+    BoardPool::Handle b = pool.acquire(16, 30, 99);
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool.idle(), 1u);
+    EXPECT_EQ(BoardPool::sizeClass(16, 30), 9);
+    EXPECT_EQ(BoardPool::sizeClass(1, 1), 0);
+}
+
+TEST(BoardPool_Acquire, ResizedBoardsReturnToTheirNewClass) {
+    BoardPool pool;
+    Board* grown;
+    {
+        BoardPool::Handle board = pool.acquire(1, 1, 0, uint64_t{0});
+        board->reset(16, 30, 99);
+        grown = board.get();
+    }
+    BoardPool::Handle tiny = pool.acquire(1, 1, 0, uint64_t{0});
+    BoardPool::Handle expert = pool.acquire(16, 30, 99, uint64_t{1});
+    EXPECT_NE(tiny.get(), grown);
+    EXPECT_EQ(expert.get(), grown);
+}
@@ -10,6 +10,7 @@
 #include <sstream>
 #include <vector>
 #include "minesweeper/board.hpp"
+#include "minesweeper/thread_pool.hpp"
 #include "minesweeper/tile.hpp"
 #include "minesweeper/tile_state.hpp"
 
@@ -109,6 +110,71 @@ TEST(Board_Adjacency, KnownCountsAreCorrect) {
     EXPECT_EQ(board.getTile(4,4)->adjacentMines, 1u);
 }
 
+// ---------- Mine placement ----------
+
+namespace {
+    int countMines(Board& board) {
+        int mines = 0;
+        for (int r = 0; r < board.getRows(); ++r)
+            for (int c = 0; c < board.getColumns(); ++c)
+                if (board.getTile(r, c)->isMine) ++mines;
+        return mines;
+    }
+}
+
+TEST(Board_Mines, SameSeedGivesSameBoard) {
+    Board a(16, 30, 99, uint64_t{42});
+    Board b(16, 30, 99, uint64_t{42});
+    Board c(16, 30, 99, uint64_t{43});
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a == c);
+
+    // Reseeding through reset reproduces the layout too
+    c.reset(16, 30, 99, 42);
+    EXPECT_TRUE(a == c);
+}
+
+TEST(Board_Mines, UnseededResetsDiffer) {
+    Board a(16, 30, 99, uint64_t{7});
+    Board first = a;
+    a.reset(16, 30, 99);
+    EXPECT_FALSE(a == first);
+}
+
+TEST(Board_Mines, StreamBoardsResetToRandomLayouts) {
+    // Boards read from a stream get a random seed like any unseeded board
+    std::istringstream first(kTestBoard), second(kTestBoard);
+    Board a(first), b(second);
+    a.reset(16, 30, 99);
+    b.reset(16, 30, 99);
+    EXPECT_FALSE(a == b);
+}
+
+TEST(Board_Mines, PlacesExactCountAtAnyDensity) {
+    for (int mines : {0, 1, 40, 255, 256}) {
+        Board board(16, 16, mines, static_cast<uint64_t>(mines));
+        EXPECT_EQ(countMines(board), mines);
+    }
+
+    // 99% mines on a large board used to spin in the rejection loop
+    Board dense(1000, 1000, 990000, uint64_t{1});
+    EXPECT_EQ(countMines(dense), 990000);
+}
+
+TEST(Board_Mines, LayoutConstructorPlacesGivenMines) {
+    std::vector<Cell> layout = {{0, 0}, {0, 2}, {2, 1}};
+    Board board(3, 3, layout);
+    EXPECT_EQ(board.getMines(), 3);
+    EXPECT_EQ(countMines(board), 3);
+    EXPECT_TRUE(board.getTile(0, 2)->isMine);
+    EXPECT_EQ(board.getTile(1, 1)->adjacentMines, 3);
+    EXPECT_EQ(board.getTile(0, 1)->adjacentMines, 2);
+
+    board.reset(2, 2, std::vector<Cell>{{1, 1}});
+    EXPECT_EQ(board.getMines(), 1);
+    EXPECT_EQ(board.getTile(0, 0)->adjacentMines, 1);
+}
+
 // ---------- Reveal behavior ----------
 
 TEST(Board_Reveal, RevealingSafeTileShowsRevealedAndNotGameOver) {
@@ -139,6 +205,337 @@ TEST(Board_Reveal, RevealingMineExplodesAndEndsGame) {
     EXPECT_EQ(board.getTile(0,2)->state, TileState::EXPLODED);
 }
 
+TEST(Board_Reveal, RevealingAnExplodedMineAgainReportsNoChange) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+
+    std::vector<Cell> revealed;
+    EXPECT_TRUE(board.revealTile(0, 2, revealed));
+    EXPECT_EQ(revealed.size(), 1u);
+    revealed.clear();
+    EXPECT_FALSE(board.revealTile(0, 2, revealed));
+    EXPECT_TRUE(revealed.empty());
+}
+
+TEST(Board_Reveal, CascadeOnLargeEmptyBoardDoesNotOverflow) {
+    // A mine-free board reveals everything from one click; the old recursive
+    // fill blew the stack long before this size.
+    Board board(2000, 2000, 0);
+
+    std::vector<Cell> revealed;
+    EXPECT_FALSE(board.revealTile(1000, 1000, revealed));
+    EXPECT_EQ(revealed.size(), 2000u * 2000u);
+    EXPECT_EQ(board.getTile(0, 0)->state, TileState::REVEALED);
+    EXPECT_EQ(board.getTile(1999, 1999)->state, TileState::REVEALED);
+}
+
+TEST(Board_Reveal, RevealedBufferListsEachChangedTileOnce) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+
+    // Snapshot states, reveal an empty corner, then diff against the snapshot
+    std::vector<TileState> before;
+    for (int r = 0; r < board.getRows(); ++r)
+        for (int c = 0; c < board.getColumns(); ++c)
+            before.push_back(board.getTile(r, c)->state);
+
+    std::vector<Cell> revealed;
+    ASSERT_FALSE(board.revealTile(4, 0, revealed));
+
+    std::vector<int> seen(before.size(), 0);
+    for (Cell cell : revealed) {
+        int i = cell.row * board.getColumns() + cell.col;
+        EXPECT_EQ(before[i], TileState::COVERED);
+        EXPECT_EQ(board.getTile(cell.row, cell.col)->state, TileState::REVEALED);
+        seen[i]++;
+    }
+    for (int r = 0; r < board.getRows(); ++r) {
+        for (int c = 0; c < board.getColumns(); ++c) {
+            int i = r * board.getColumns() + c;
+            bool changed = before[i] != board.getTile(r, c)->state;
+            EXPECT_EQ(seen[i], changed ? 1 : 0) << "at (" << r << "," << c << ")";
+        }
+    }
+
+    // Revealing again changes nothing and appends nothing
+    size_t count = revealed.size();
+    board.revealTile(4, 0, revealed);
+    EXPECT_EQ(revealed.size(), count);
+}
+
+// ---------- Chording ----------
+
+TEST(Board_Chord, RevealsTheUnflaggedNeighborsOfASatisfiedNumber) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.revealTile(1, 2);                         // a 3
+    board.toggleTile(0, 2);
+    board.toggleTile(1, 1);
+
+    std::vector<Cell> opened;
+    EXPECT_FALSE(board.chordTile(1, 2, opened));    // two flags: nothing happens
+    EXPECT_TRUE(opened.empty());
+
+    board.toggleTile(2, 3);
+    EXPECT_FALSE(board.chordTile(1, 2, opened));
+    EXPECT_EQ(opened.size(), 5u);
+    for (const Cell& cell : opened) {
+        EXPECT_EQ(board.getTile(cell.row, cell.col)->state, TileState::REVEALED);
+    }
+    EXPECT_FALSE(board.chordTile(1, 2));            // nothing left to open
+    EXPECT_FALSE(board.chordTile(4, 0));            // covered, not a number
+}
+
+TEST(Board_Chord, EmptyNeighborsShareOneFloodFill) {
+    Board board(6, 6, std::vector<Cell>{{0, 0}});
+    board.setUndoDepth(2);
+    board.revealTile(1, 1);
+    board.toggleTile(0, 0);
+
+    std::vector<Cell> opened;
+    EXPECT_FALSE(board.chordTile(1, 1, opened));
+    EXPECT_TRUE(board.isWon());
+    EXPECT_EQ(opened.size(), 34u);                  // every other safe tile, once each
+    std::vector<int> seen(36, 0);
+    for (const Cell& cell : opened) {
+        EXPECT_EQ(++seen[cell.row * 6 + cell.col], 1);
+    }
+
+    // The chord is one move
+    ASSERT_TRUE(board.undo());
+    EXPECT_FALSE(board.isWon());
+    EXPECT_EQ(board.getTile(5, 5)->state, TileState::COVERED);
+    EXPECT_EQ(board.getTile(0, 0)->state, TileState::FLAGGED);
+}
+
+TEST(Board_Chord, AWrongFlagExplodes) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.revealTile(1, 2);
+    board.toggleTile(0, 1);                         // wrong: the mine is at (2,3)
+    board.toggleTile(0, 2);
+    board.toggleTile(1, 1);
+
+    std::vector<Cell> opened;
+    EXPECT_TRUE(board.chordTile(1, 2, opened));
+    EXPECT_TRUE(board.isLost());
+    EXPECT_EQ(board.getTile(2, 3)->state, TileState::EXPLODED);
+    EXPECT_EQ(opened.size(), 5u);                   // the mine and four safe tiles
+}
+
+// ---------- Batched moves ----------
+
+TEST(Board_Apply, DiffHasTheNetChangePerTile) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    std::vector<Move> moves {
+        {MOVE_REVEAL, 4, 0},        // cascade
+        {MOVE_TOGGLE, 0, 5}, {MOVE_TOGGLE, 0, 5},                         // ends QUESTIONED
+        {MOVE_TOGGLE, 0, 0}, {MOVE_TOGGLE, 0, 0}, {MOVE_TOGGLE, 0, 0},    // back to COVERED
+        {MOVE_REVEAL, 4, 0},        // already open
+        {MOVE_REVEAL, 1, 2},
+    };
+    std::istringstream twinText(kTestBoard);
+    Board twin(twinText);
+    std::vector<Cell> opened;
+    twin.revealTile(4, 0, opened);
+    twin.revealTile(1, 2, opened);
+
+    const std::vector<TileChange>& diff = board.apply(moves);
+    ASSERT_EQ(diff.size(), opened.size() + 1);
+    std::vector<int> seen(30, 0);
+    for (const TileChange& change : diff) {
+        int r = change.index / 6, c = change.index % 6;
+        EXPECT_EQ(++seen[change.index], 1);
+        EXPECT_EQ(change.state, board.getTile(r, c)->state);
+        if (change.state == TileState::REVEALED) {
+            EXPECT_EQ(change.adjacentMines, board.getTile(r, c)->adjacentMines);
+        } else {
+            EXPECT_EQ(change.adjacentMines, 0);
+        }
+    }
+    EXPECT_EQ(seen[0 * 6 + 5], 1);
+    EXPECT_EQ(board.getTile(0, 5)->state, TileState::QUESTIONED);
+    EXPECT_EQ(seen[0], 0);
+    for (const Cell& cell : opened) {
+        EXPECT_EQ(seen[cell.row * 6 + cell.col], 1);
+    }
+}
+
+TEST(Board_Apply, ReusesItsBufferAndReportsExplosions) {
+    Board board(8, 8, std::vector<Cell>{{7, 7}});
+    std::vector<Move> flags {{MOVE_TOGGLE, 0, 0}, {MOVE_TOGGLE, 0, 1}};
+    const std::vector<TileChange>& first = board.apply(flags);
+    EXPECT_EQ(first.size(), 2u);
+    const TileChange* buffer = first.data();
+
+    std::vector<Move> boom {{MOVE_REVEAL, 7, 7}};
+    const std::vector<TileChange>& second = board.apply(boom.data(), boom.size());
+    EXPECT_EQ(&second, &first);
+    EXPECT_EQ(second.data(), buffer);
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(second[0].index, 63);
+    EXPECT_EQ(second[0].state, TileState::EXPLODED);
+    EXPECT_TRUE(board.isLost());
+
+    EXPECT_TRUE(board.apply(nullptr, 0).empty());
+}
+
+// ---------- First-click policy ----------
+
+namespace {
+    // Counts must match a board built from scratch with the same mines
+    void expectCountsMatchLayout(Board& board) {
+        std::vector<Cell> mines;
+        for (int r = 0; r < board.getRows(); ++r)
+            for (int c = 0; c < board.getColumns(); ++c)
+                if (board.getTile(r, c)->isMine) mines.push_back({r, c});
+        Board fresh(board.getRows(), board.getColumns(), mines);
+        for (int r = 0; r < board.getRows(); ++r)
+            for (int c = 0; c < board.getColumns(); ++c)
+                EXPECT_EQ(board.getTile(r, c)->adjacentMines, fresh.getTile(r, c)->adjacentMines)
+                    << "at (" << r << "," << c << ")";
+    }
+}
+
+TEST(Board_FirstClick, SafeMovesTheClickedMine) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.setFirstClick(FIRST_CLICK_SAFE);
+    int mines = countMines(board);
+    ASSERT_TRUE(board.getTile(0, 2)->isMine);
+
+    EXPECT_FALSE(board.revealTile(0, 2));
+    EXPECT_FALSE(board.isLost());
+    EXPECT_EQ(board.getTile(0, 2)->state, TileState::REVEALED);
+    EXPECT_EQ(countMines(board), mines);
+    expectCountsMatchLayout(board);
+}
+
+TEST(Board_FirstClick, OpeningClearsTheNeighborhoodAndOnlyAppliesOnce) {
+    Board board(9, 9, 60, uint64_t{11});
+    board.setFirstClick(FIRST_CLICK_OPENING);
+    board.revealTile(4, 4);
+
+    EXPECT_FALSE(board.isLost());
+    EXPECT_EQ(board.getTile(4, 4)->adjacentMines, 0);
+    for (int r = 3; r <= 5; ++r)
+        for (int c = 3; c <= 5; ++c)
+            EXPECT_EQ(board.getTile(r, c)->state, TileState::REVEALED);
+    EXPECT_EQ(countMines(board), 60);
+    expectCountsMatchLayout(board);
+
+    // Later clicks are not protected
+    for (int i = 0; i < 81; ++i) {
+        if (board.getTile(i / 9, i % 9)->isMine) {
+            EXPECT_TRUE(board.revealTile(i / 9, i % 9));
+            break;
+        }
+    }
+}
+
+TEST(Board_FirstClick, FallsBackToTheTileWhenTheAreaCannotBeCleared) {
+    // 3x3 with 8 mines: nowhere to put the neighbors' mines
+    Board board(3, 3, 8, uint64_t{3});
+    board.setFirstClick(FIRST_CLICK_OPENING);
+    board.reset(3, 3, 8, uint64_t{3});          // the policy survives reset
+    EXPECT_FALSE(board.revealTile(1, 1));
+    EXPECT_EQ(board.getTile(1, 1)->adjacentMines, 8);
+    EXPECT_TRUE(board.isWon());
+}
+
+// ---------- Game-state counters ----------
+
+TEST(Board_State, WinAfterRevealingEverySafeTile) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    EXPECT_FALSE(board.isWon());
+    EXPECT_FALSE(board.isLost());
+
+    // The empty corner cascades but does not finish the board
+    board.revealTile(4, 0);
+    EXPECT_FALSE(board.isWon());
+
+    for (int r = 0; r < board.getRows(); ++r) {
+        for (int c = 0; c < board.getColumns(); ++c) {
+            if (!isExpectedMine(r, c)) board.revealTile(r, c);
+        }
+    }
+    EXPECT_TRUE(board.isWon());
+    EXPECT_FALSE(board.isLost());
+}
+
+TEST(Board_State, LostAfterExplosion) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.revealTile(1, 1);
+    EXPECT_TRUE(board.isLost());
+    EXPECT_FALSE(board.isWon());
+}
+
+TEST(Board_State, RevealingAnExplodedMineAgainChangesNothing) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.setUndoDepth(8);
+    EXPECT_TRUE(board.revealTile(1, 1));
+    EXPECT_FALSE(board.revealTile(1, 1));
+    EXPECT_TRUE(board.isLost());
+    EXPECT_EQ(board.getTile(1, 1)->state, TileState::EXPLODED);
+
+    // One explosion counted and one move recorded: a single undo clears it
+    EXPECT_EQ(board.undoable(), 1u);
+    ASSERT_TRUE(board.undo());
+    EXPECT_FALSE(board.isLost());
+    EXPECT_EQ(board.getTile(1, 1)->state, TileState::COVERED);
+}
+
+TEST(Board_State, MinesRemainingTracksFlags) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    EXPECT_EQ(board.minesRemaining(), 4);
+
+    board.toggleTile(0, 0);                   // flagged
+    board.toggleTile(0, 1);                   // flagged
+    EXPECT_EQ(board.minesRemaining(), 2);
+    board.toggleTile(0, 0);                   // questioned
+    EXPECT_EQ(board.minesRemaining(), 3);
+    board.toggleTile(0, 0);                   // covered
+    EXPECT_EQ(board.minesRemaining(), 3);
+
+    board.reset(5, 6, 4);
+    EXPECT_EQ(board.minesRemaining(), 4);
+}
+
+TEST(Board_State, RevealedTilesFollowsUndoAndRedo) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.setUndoDepth(4);
+    EXPECT_EQ(board.revealedTiles(), 0);
+    board.revealTile(0, 0);                   // 1
+    board.revealTile(1, 1);                   // mine
+    EXPECT_EQ(board.revealedTiles(), 2);
+    board.undo();
+    board.undo();
+    EXPECT_EQ(board.revealedTiles(), 0);
+    board.redo();
+    EXPECT_EQ(board.revealedTiles(), 1);
+}
+
+TEST(Board_State, CountersSurviveSaveAndLoad) {
+    std::istringstream iss(kTestBoard);
+    Board original(iss);
+    original.toggleTile(0, 2);
+    original.revealTile(4, 0);
+
+    std::stringstream buffer;
+    ASSERT_EQ(original.save(buffer), 0);
+    Board restored(5, 6, 4);
+    ASSERT_EQ(restored.load(buffer), 0);
+    EXPECT_EQ(restored.minesRemaining(), 3);
+    EXPECT_FALSE(restored.isWon());
+    EXPECT_FALSE(restored.isLost());
+}
+
 // ---------- Flag/mark cycle ----------
 
 TEST(Board_Flagging, ToggleTileCyclesMarkStatesFromCovered) {
@@ -200,4 +597,236 @@ TEST(Board_SaveLoad, SaveThenLoad_RoundTripPreservesBoard) {
             //ASSERT_EQ(original.getTile(r, c), restored.getTile(r, c)) << "Tiles at [" << r << "," << c << "] Not Equal";
         }
     }
-}
\ No newline at end of file
+}
+
+// ---------- Parallel generation ---------------
+
+TEST(Board_Bands, SameBoardForAnyThreadCount) {
+    // 3000 columns make bands of 87 rows, so 400 rows is 5 bands
+    Board serial(1, 1, 0, uint64_t{0}), one(1, 1, 0, uint64_t{0}), three(1, 1, 0, uint64_t{0});
+    ThreadPool single(1), several(3);
+    serial.reset(400, 3000, 180000, 11, nullptr);
+    one.reset(400, 3000, 180000, 11, &single);
+    three.reset(400, 3000, 180000, 11, &several);
+    EXPECT_TRUE(serial == one);
+    EXPECT_TRUE(serial == three);
+
+    // Exactly `mines` mines, with the counts a serial pass gives
+    std::vector<Cell> mines;
+    for (int r = 0; r < 400; r++) {
+        for (int c = 0; c < 3000; c++) {
+            if (three.getTile(r, c)->isMine) mines.push_back({r, c});
+        }
+    }
+    EXPECT_EQ(mines.size(), 180000u);
+    EXPECT_TRUE(Board(400, 3000, mines) == three);
+
+    one.reset(400, 3000, 180000, 12, &single);
+    EXPECT_FALSE(one == three);
+}
+
+TEST(Board_Bands, GeneratesFromATaskOnTheSamePool) {
+    ThreadPool pool(1);
+    Board serial(1, 1, 0, uint64_t{0}), nested(1, 1, 0, uint64_t{0});
+    serial.reset(400, 3000, 180000, 11, nullptr);
+    pool.submit([&] { nested.reset(400, 3000, 180000, 11, &pool); });
+    pool.wait();
+    EXPECT_TRUE(serial == nested);
+}
+
+TEST(Board_Bands, MinesSpreadEvenlyOverTheBands) {
+    ThreadPool pool(2);
+    Board board(1, 1, 0, uint64_t{0});
+    board.reset(870, 3000, 261000, 5, &pool);   // 10 bands of 87 rows, 10% mines
+    for (int band = 0; band < 10; band++) {
+        int count = 0;
+        for (int r = band * 87; r < (band + 1) * 87; r++) {
+            for (int c = 0; c < 3000; c++) count += board.getTile(r, c)->isMine;
+        }
+        EXPECT_NEAR(count, 26100, 6 * 154) << "band " << band;   // 6 standard deviations
+    }
+
+    board.reset(9, 9, 10, 5, nullptr);
+    int mines = 0;
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) mines += board.getTile(r, c)->isMine;
+    }
+    EXPECT_EQ(mines, 10);
+}
+
+// ---------- Storage layout ---------------
+
+TEST(Board_Storage, RowsAreContiguousWithASentinelBorder) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+
+    // Walking a row pointer must visit the same tiles as getTile
+    for (int r = 0; r < board.getRows(); ++r) {
+        Tile* row = board.getTile(r, 0);
+        for (int c = 0; c < board.getColumns(); ++c) {
+            EXPECT_EQ(row + c, board.getTile(r, c));
+        }
+    }
+    // Rows are stored columns + 2 apart; the tiles in between are sentinels
+    // (revealed, no mine) that stop the flood fill
+    ptrdiff_t stride = board.getTile(1, 0) - board.getTile(0, 0);
+    EXPECT_EQ(stride, board.getColumns() + 2);
+    const Tile* right = board.getTile(0, board.getColumns() - 1) + 1;
+    EXPECT_EQ(right->state, TileState::REVEALED);
+    EXPECT_FALSE(right->isMine);
+    EXPECT_EQ(sizeof(Tile), 1u);
+}
+
+TEST(Board_Storage, CascadeStopsAtEveryEdge) {
+    // No mines: one click must open exactly rows * columns tiles, in any shape
+    for (int rows : {1, 2, 7}) {
+        for (int cols : {1, 3, 64, 65}) {
+            Board board(rows, cols, std::vector<Cell>{});
+            std::vector<Cell> opened;
+            EXPECT_FALSE(board.revealTile(rows / 2, cols / 2, opened));
+            EXPECT_EQ(opened.size(), static_cast<size_t>(rows * cols)) << rows << "x" << cols;
+            EXPECT_TRUE(board.isWon());
+            for (const Cell& cell : opened) {
+                EXPECT_TRUE(board.inBounds(cell.row, cell.col));
+            }
+        }
+    }
+}
+
+// ---------- Undo / redo ---------------
+
+TEST(Board_Undo, OffByDefault) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.revealTile(4, 0);
+    EXPECT_EQ(board.getUndoDepth(), 0u);
+    EXPECT_FALSE(board.undo());
+    EXPECT_EQ(board.getTile(4, 0)->state, TileState::REVEALED);
+}
+
+TEST(Board_Undo, CascadeUndoesAndRedoesAsOneMove) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.setUndoDepth(8);
+    Board start = board;
+
+    std::vector<Cell> opened;
+    board.revealTile(4, 0, opened);
+    ASSERT_GT(opened.size(), 1u);
+    Board played = board;
+
+    std::vector<Cell> changed;
+    EXPECT_TRUE(board.undo(changed));
+    EXPECT_TRUE(board == start);
+    EXPECT_EQ(changed.size(), opened.size());
+    EXPECT_FALSE(board.undo());
+    EXPECT_FALSE(board.isWon());
+
+    EXPECT_TRUE(board.redo());
+    EXPECT_TRUE(board == played);
+    EXPECT_FALSE(board.redo());
+}
+
+TEST(Board_Undo, RestoresCountersAndFlags) {
+    Board board(6, 6, std::vector<Cell>{{0, 0}});
+    board.setUndoDepth(8);
+    board.toggleTile(0, 0);
+    EXPECT_FALSE(board.revealTile(5, 5));
+    EXPECT_TRUE(board.isWon());
+    EXPECT_EQ(board.minesRemaining(), 0);
+
+    ASSERT_TRUE(board.undo());      // the cascade
+    EXPECT_FALSE(board.isWon());
+    EXPECT_EQ(board.getTile(5, 5)->state, TileState::COVERED);
+    EXPECT_EQ(board.minesRemaining(), 0);
+    ASSERT_TRUE(board.undo());      // the flag
+    EXPECT_EQ(board.minesRemaining(), 1);
+    EXPECT_EQ(board.undoable(), 0u);
+    EXPECT_EQ(board.redoable(), 2u);
+
+    // A new move drops what could have been redone
+    ASSERT_TRUE(board.redo());
+    EXPECT_EQ(board.toggleTile(0, 0), TileState::QUESTIONED);
+    EXPECT_EQ(board.redoable(), 0u);
+    EXPECT_EQ(board.undoable(), 2u);
+    EXPECT_EQ(board.minesRemaining(), 1);
+}
+
+TEST(Board_Undo, NoOpMovesAreNotRecorded) {
+    std::istringstream iss(kTestBoard);
+    Board board(iss);
+    board.setUndoDepth(8);
+    board.revealTile(4, 0);
+    board.revealTile(4, 0);         // already revealed
+    board.toggleTile(4, 0);         // cannot flag a revealed tile
+    EXPECT_EQ(board.undoable(), 1u);
+}
+
+TEST(Board_Undo, DepthIsBoundedAndResetForgets) {
+    Board board(4, 4, 0, uint64_t{3});
+    board.setUndoDepth(3);
+    for (int c = 0; c < 4; c++) {
+        board.toggleTile(0, c);
+    }
+    EXPECT_EQ(board.undoable(), 3u);
+    while (board.undo()) {}
+    EXPECT_EQ(board.getTile(0, 0)->state, TileState::FLAGGED);    // oldest move was dropped
+    EXPECT_EQ(board.getTile(0, 1)->state, TileState::COVERED);
+
+    board.reset(4, 4, 2);
+    EXPECT_EQ(board.undoable() + board.redoable(), 0u);
+    EXPECT_EQ(board.getUndoDepth(), 3u);
+}
+
+TEST(Board_Undo, UndoingTheFirstClickPutsTheMinesBack) {
+    Board board(9, 9, 30, uint64_t{5});
+    board.setFirstClick(FIRST_CLICK_OPENING);
+    board.setUndoDepth(4);
+    Board start = board;
+    ASSERT_TRUE(start.getTile(4, 4)->isMine || start.getTile(4, 5)->isMine ||
+                start.getTile(3, 4)->isMine || start.getTile(5, 4)->isMine);
+
+    EXPECT_FALSE(board.revealTile(4, 4));
+    Board played = board;
+    ASSERT_TRUE(board.undo());
+    EXPECT_TRUE(board == start);
+    ASSERT_TRUE(board.redo());
+    EXPECT_TRUE(board == played);
+}
+
+// ---------- Instrumentation ---------------
+
+TEST(Board_Stats, CountsRevealsCascadesAndToggles) {
+    Board board(20, 20, std::vector<Cell>{});   // no mines: one click opens everything
+    BoardStats st = board.stats();
+#ifdef MS_ENABLE_STATS
+    ASSERT_TRUE(st.enabled);
+    board.resetStats();
+    board.revealTile(0, 0);
+    board.revealTile(5, 5);                    // already revealed: counted, opens nothing
+    board.toggleTile(5, 5);
+    st = board.stats();
+    EXPECT_EQ(st.reveals, 2u);
+    EXPECT_EQ(st.cascades, 1u);
+    EXPECT_EQ(st.cascadeTiles, 400u);
+    EXPECT_EQ(st.maxCascadeTiles, 400u);
+    EXPECT_EQ(st.maxCascadeDepth, 20u);          // Chebyshev rings from the corner
+    EXPECT_GE(st.maxTilesTouched, 400u);
+    EXPECT_EQ(st.toggles, 1u);
+
+    std::stringstream buffer;
+    ASSERT_EQ(board.save(buffer), 0);
+    ASSERT_EQ(board.load(buffer), 0);
+    st = board.stats();
+    EXPECT_EQ(st.saves, 1u);
+    EXPECT_EQ(st.loads, 1u);
+    EXPECT_EQ(st.bytesSaved, buffer.str().size());
+    EXPECT_GT(st.bytesLoaded, 0u);
+#else
+    // Compiled out: the snapshot is empty and the hooks do nothing
+    board.revealTile(0, 0);
+    st = board.stats();
+    EXPECT_FALSE(st.enabled);
+    EXPECT_EQ(st.reveals, 0u);
+#endif
+}
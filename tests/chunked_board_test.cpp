@@ -0,0 +1,125 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/chunked_board_test.cpp
+#include <gtest/gtest.h>
+#include <climits>
+#include <sstream>
+#include <vector>
+#include "minesweeper/chunked_board.hpp"
+#include "minesweeper/board.hpp"
+
+namespace {
+    // Copy a chunked board's mine layout into a regular Board via the text layout format
+    Board toBoard(ChunkedBoard& chunked) {
+        std::ostringstream layout;
+        layout << chunked.getRows() << " " << chunked.getColumns() << " 0\n";
+        for (int r = 0; r < chunked.getRows(); ++r) {
+            for (int c = 0; c < chunked.getColumns(); ++c) {
+                layout << (chunked.getTile(r, c)->isMine ? "* " : ". ");
+            }
+            layout << "\n";
+        }
+        std::istringstream in(layout.str());
+        return Board(in);
+    }
+}
+
+TEST(ChunkedBoard_Generation, SameSeedSameMines) {
+    ChunkedBoard a(300, 300, 0.2, 9);
+    ChunkedBoard b(300, 300, 0.2, 9);
+    ChunkedBoard c(300, 300, 0.2, 10);
+    int same = 0, diff = 0;
+    for (int r = 0; r < 300; r += 7) {
+        for (int col = 0; col < 300; col += 5) {
+            EXPECT_EQ(a.getTile(r, col)->isMine, b.getTile(r, col)->isMine);
+            (a.getTile(r, col)->isMine == c.getTile(r, col)->isMine ? same : diff)++;
+        }
+    }
+    EXPECT_GT(diff, 0);
+}
+
+TEST(ChunkedBoard_Generation, AdjacentCountsCrossChunkBorders) {
+    // 150x140 spans 3x3 chunks, including partial ones at the edges
+    ChunkedBoard chunked(150, 140, 0.18, 1234);
+    Board board = toBoard(chunked);
+    for (int r = 0; r < 150; ++r) {
+        for (int c = 0; c < 140; ++c) {
+            ASSERT_EQ(chunked.getTile(r, c)->adjacentMines, board.getTile(r, c)->adjacentMines)
+                << "at (" << r << "," << c << ")";
+        }
+    }
+}
+
+TEST(ChunkedBoard_Reveal, MatchesBoardReveal) {
+    ChunkedBoard chunked(150, 140, 0.12, 77);
+    Board board = toBoard(chunked);
+
+    // Click every 13th tile on both boards and compare the results
+    for (int r = 0; r < 150; r += 13) {
+        for (int c = 0; c < 140; c += 13) {
+            EXPECT_EQ(chunked.revealTile(r, c), board.revealTile(r, c));
+        }
+    }
+    for (int r = 0; r < 150; ++r) {
+        for (int c = 0; c < 140; ++c) {
+            ASSERT_EQ(chunked.getTile(r, c)->state, board.getTile(r, c)->state)
+                << "at (" << r << "," << c << ")";
+        }
+    }
+}
+
+TEST(ChunkedBoard_Reveal, RevealingAnExplodedMineAgainChangesNothing) {
+    ChunkedBoard board(64, 64, 0.2, 3);
+    int row = 0, col = 0;
+    while (!board.getTile(row, col)->isMine) {
+        if (++col == 64) { col = 0; ++row; }
+    }
+
+    std::vector<Cell> revealed;
+    EXPECT_TRUE(board.revealTile(row, col, revealed));
+    ASSERT_EQ(revealed.size(), 1u);
+    EXPECT_FALSE(board.revealTile(row, col, revealed));
+    EXPECT_EQ(revealed.size(), 1u);
+    EXPECT_TRUE(board.isLost());
+    EXPECT_EQ(board.getRevealedCount(), 0);
+    EXPECT_EQ(board.getTile(row, col)->state, TileState::EXPLODED);
+}
+
+TEST(ChunkedBoard_Memory, HugeBoardOnlyCreatesTouchedChunks) {
+    ChunkedBoard board(INT_MAX, INT_MAX, 0.2, 5);
+    EXPECT_EQ(board.chunkCount(), 0u);
+
+    board.toggleTile(1000000000, 2000000000);
+    EXPECT_EQ(board.getTile(1000000000, 2000000000)->state, TileState::FLAGGED);
+    EXPECT_EQ(board.chunkCount(), 1u);
+
+    // Reading a far-away tile creates a clean chunk that can be evicted
+    bool mine = board.getTile(5, 5)->isMine;
+    unsigned adjacent = board.getTile(5, 5)->adjacentMines;
+    EXPECT_EQ(board.chunkCount(), 2u);
+    EXPECT_EQ(board.evictClean(), 1u);
+    EXPECT_EQ(board.chunkCount(), 1u);
+
+    // ...and regenerates identically, while the modified chunk kept its flag
+    EXPECT_EQ(board.getTile(5, 5)->isMine, mine);
+    EXPECT_EQ(board.getTile(5, 5)->adjacentMines, adjacent);
+    EXPECT_EQ(board.getTile(1000000000, 2000000000)->state, TileState::FLAGGED);
+}
+
+TEST(ChunkedBoard_Flagging, ToggleCyclesLikeBoard) {
+    ChunkedBoard board(64, 64, 0.0, 1);
+    board.toggleTile(3, 3);
+    EXPECT_EQ(board.getTile(3, 3)->state, TileState::FLAGGED);
+    EXPECT_EQ(board.toggleTile(3, 3), TileState::QUESTIONED);
+    EXPECT_EQ(board.toggleTile(3, 3), TileState::COVERED);
+
+    // No mines: one click reveals the whole board
+    EXPECT_FALSE(board.revealTile(0, 0));
+    EXPECT_EQ(board.getRevealedCount(), 64 * 64);
+    EXPECT_FALSE(board.isLost());
+}
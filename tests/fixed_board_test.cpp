@@ -0,0 +1,128 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/fixed_board_test.cpp
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "minesweeper/fixed_board.hpp"
+#include "minesweeper/board.hpp"
+#include "minesweeper/binary_board_serializer.hpp"
+#include "minesweeper/text_board_serializer.hpp"
+
+static_assert(IsBoard<Board>::value, "Board must satisfy IsBoard");
+static_assert(IsBoard<ExpertBoard>::value, "FixedBoard must satisfy IsBoard");
+static_assert(!IsBoard<Tile>::value, "Tile is not a board");
+
+// Same tiles, tile for tile
+template <class A, class B>
+static void expectSameTiles(A& a, B& b) {
+    ASSERT_EQ(a.getRows(), b.getRows());
+    ASSERT_EQ(a.getColumns(), b.getColumns());
+    for (int r = 0; r < a.getRows(); ++r) {
+        for (int c = 0; c < a.getColumns(); ++c) {
+            ASSERT_TRUE(*a.getTile(r, c) == *b.getTile(r, c)) << "at " << r << "," << c;
+        }
+    }
+}
+
+// ---------- Layout and play match Board ---------------
+
+TEST(FixedBoard_Board, SeededLayoutMatchesBoard) {
+    for (uint64_t seed : {1u, 2u, 3u, 99u}) {
+        ExpertBoard fixed(seed);
+        Board board(16, 30, 99, seed);
+        expectSameTiles(fixed, board);
+    }
+}
+
+TEST(FixedBoard_Board, RevealsAndFirstClickMatchBoard) {
+    BeginnerBoard fixed(7);
+    Board board(9, 9, 10, uint64_t(7));
+    fixed.setFirstClick(FIRST_CLICK_OPENING);
+    board.setFirstClick(FIRST_CLICK_OPENING);
+
+    std::vector<Cell> fromFixed, fromBoard;
+    EXPECT_FALSE(fixed.revealTile(4, 4, fromFixed));
+    EXPECT_FALSE(board.revealTile(4, 4, fromBoard));
+    EXPECT_GT(fromFixed.size(), 1u);   // an opening
+    ASSERT_EQ(fromFixed.size(), fromBoard.size());
+    for (size_t i = 0; i < fromFixed.size(); ++i) {
+        EXPECT_EQ(fromFixed[i].row, fromBoard[i].row);
+        EXPECT_EQ(fromFixed[i].col, fromBoard[i].col);
+    }
+    expectSameTiles(fixed, board);
+    EXPECT_EQ(fixed.isWon(), board.isWon());
+
+    EXPECT_EQ(fixed.toggleTile(0, 0), board.toggleTile(0, 0));
+    EXPECT_EQ(fixed.minesRemaining(), board.minesRemaining());
+
+    // Revealing a mine, then revealing it again, behaves the same on both boards
+    int row = 0, col = 1;
+    while (!board.getTile(row, col)->isMine || board.getTile(row, col)->state != TileState::COVERED) {
+        if (++col == 9) { col = 0; ++row; }
+    }
+    fromFixed.clear();
+    fromBoard.clear();
+    EXPECT_TRUE(fixed.revealTile(row, col, fromFixed));
+    EXPECT_TRUE(board.revealTile(row, col, fromBoard));
+    EXPECT_FALSE(fixed.revealTile(row, col, fromFixed));
+    EXPECT_FALSE(board.revealTile(row, col, fromBoard));
+    EXPECT_EQ(fromFixed.size(), 1u);
+    EXPECT_EQ(fromBoard.size(), 1u);
+    EXPECT_TRUE(fixed.isLost());
+    EXPECT_TRUE(board.isLost());
+    expectSameTiles(fixed, board);
+    EXPECT_EQ(fixed.isWon(), board.isWon());
+}
+
+TEST(FixedBoard_Play, CornerCascadeOpensEverythingWithoutMines) {
+    FixedBoard<4, 5, 0> fixed(1);
+    std::vector<Cell> opened;
+    EXPECT_FALSE(fixed.revealTile(3, 4, opened));
+    EXPECT_EQ(opened.size(), 20u);
+    EXPECT_TRUE(fixed.isWon());
+}
+
+// ---------- Serializers ---------------
+
+TEST(FixedBoard_Serializer, TextAndBinaryRoundTrip) {
+    IntermediateBoard original(5);
+    original.revealTile(0, 0);
+    original.toggleTile(15, 15);
+
+    std::stringstream text;
+    ASSERT_EQ(original.save(text), 0);
+    IntermediateBoard fromText(6);
+    ASSERT_EQ(fromText.load(text), 0);
+    EXPECT_TRUE(fromText == original);
+    EXPECT_EQ(fromText.minesRemaining(), original.minesRemaining());
+
+    std::stringstream binary;
+    ASSERT_EQ(BinaryBoardSerializer::write(original, binary), 0);
+    IntermediateBoard fromBinary(6);
+    ASSERT_EQ(BinaryBoardSerializer::read(fromBinary, binary), 0);
+    EXPECT_TRUE(fromBinary == original);
+
+    // A Board reads what a FixedBoard wrote
+    text.clear();
+    text.seekg(0);
+    Board board;
+    ASSERT_EQ(board.load(text), 0);
+    expectSameTiles(board, original);
+}
+
+TEST(FixedBoard_Serializer, RejectsAnotherSize) {
+    Board board(9, 9, 10, uint64_t(1));
+    std::stringstream text;
+    ASSERT_EQ(board.save(text), 0);
+
+    ExpertBoard fixed(1);
+    ExpertBoard before = fixed;
+    EXPECT_EQ(TextBoardSerializer::read(fixed, text), -1);
+    EXPECT_TRUE(fixed == before);
+}
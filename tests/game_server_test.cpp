@@ -0,0 +1,170 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/game_server_test.cpp
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "minesweeper/game_server.hpp"
+
+namespace {
+    std::vector<std::string> run(GameServer& server, const std::vector<std::string>& lines) {
+        std::vector<std::string> replies;
+        server.handle(lines, replies);
+        return replies;
+    }
+}
+
+TEST(GameServer_Handle, RunsSeveralGamesInOneBatch) {
+    GameServer server(2);
+    auto replies = run(server, {
+        "NEW a 2 2 0",
+        "NEW b 9 9 10 7",
+        "REVEAL a 0 0",
+        "reveal b 4 4",
+    });
+    ASSERT_EQ(replies.size(), 4u);
+    EXPECT_EQ(replies[0], "OK a");
+    EXPECT_EQ(replies[1], "OK b");
+    EXPECT_EQ(replies[2], "DIFF a won 4 0R0 1R0 2R0 3R0");
+    EXPECT_EQ(server.games(), 2u);
+
+    // Same seed, same board, same diff
+    Board board(9, 9, 10, uint64_t{7});
+    const vector<TileChange>& diff = board.apply({{MOVE_REVEAL, 4, 4}});
+    std::string expected = std::string("DIFF b ") + (board.isLost() ? "lost " : board.isWon() ? "won " : "play ")
+        + std::to_string(diff.size());
+    for (const TileChange& change : diff) {
+        expected += " " + std::to_string(change.index) + "CRFQX"[change.state];
+        if (change.state == TileState::REVEALED) expected += std::to_string(change.adjacentMines);
+    }
+    EXPECT_EQ(replies[3], expected);
+}
+
+TEST(GameServer_Handle, ReportsErrorsAndDropsGames) {
+    GameServer server(1);
+    auto replies = run(server, {
+        "FLAG x 0 0",
+        "NEW x 3 3 0",
+        "NEW x 3 3 0",
+        "FLAG x 3 0",
+        "NEW y 0 3 0",
+        "JUMP x",
+        "MOVES x F 0 0 R 9 9",
+        "FLAG x 0 0",
+        "DROP x",
+        "",
+    });
+    EXPECT_EQ(replies[0], "ERR x no such game");
+    EXPECT_EQ(replies[1], "OK x");
+    EXPECT_EQ(replies[2], "ERR x game exists");
+    EXPECT_EQ(replies[3], "ERR x out of bounds");
+    EXPECT_EQ(replies[4], "ERR y bad size");
+    EXPECT_EQ(replies[5], "ERR - unknown command JUMP");
+    EXPECT_EQ(replies[6], "ERR x out of bounds");           // nothing applied
+    EXPECT_EQ(replies[7], "DIFF x play 1 0F");
+    EXPECT_EQ(replies[8], "OK x");
+    EXPECT_EQ(replies[9], "ERR - empty request");
+    EXPECT_EQ(server.games(), 0u);
+}
+
+TEST(GameServer_Handle, SavesAndLoadsGames) {
+    std::string dir = testing::TempDir();
+    GameServer server(1, dir);
+    auto replies = run(server, {
+        "NEW a 4 4 0",
+        "MOVES a F 1 1 F 2 2",
+        "SAVE a game_server_test.board",
+        "LOAD b game_server_test.board",
+        "RESET a 5 5 1 3",
+        "FLAG b 1 1",
+    });
+    EXPECT_EQ(replies[1], "DIFF a play 2 5F 10F");
+    EXPECT_EQ(replies[2], "OK a");
+    EXPECT_EQ(replies[3], "OK b");
+    EXPECT_EQ(replies[4], "OK a");
+    EXPECT_EQ(replies[5], "DIFF b play 1 5Q");              // the flag came along
+    unlink((dir + "/game_server_test.board").c_str());
+}
+
+TEST(GameServer_Handle, KeepsSavesInsideTheSaveDirectory) {
+    GameServer confined(1, testing::TempDir());
+    auto replies = run(confined, {
+        "NEW a 2 2 0",
+        "SAVE a /tmp/escape.board",
+        "SAVE a ../escape.board",
+        "LOAD b ..",
+        "SAVE a",
+    });
+    EXPECT_EQ(replies[1], "ERR a bad save name");
+    EXPECT_EQ(replies[2], "ERR a bad save name");
+    EXPECT_EQ(replies[3], "ERR b bad save name");
+    EXPECT_EQ(replies[4], "ERR a usage: SAVE <id> <name>");
+
+    GameServer disabled(1);
+    replies = run(disabled, {"NEW a 2 2 0", "SAVE a x.board"});
+    EXPECT_EQ(replies[1], "ERR a saving disabled");
+}
+
+TEST(GameServer_Latency, PercentilesAreBucketUpperBounds) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(99), 0u);
+    for (uint64_t ns = 1; ns <= 100; ns++) {
+        histogram.record(ns * 1000);
+    }
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.max(), 100000u);
+    EXPECT_EQ(histogram.percentile(100), 100000u);
+
+    // Within one sub-bucket (12.5%) above the true value
+    uint64_t p50 = histogram.percentile(50);
+    uint64_t p99 = histogram.percentile(99);
+    EXPECT_GE(p50, 50000u);
+    EXPECT_LE(p50, 50000u * 9 / 8);
+    EXPECT_GE(p99, 99000u);
+    EXPECT_LE(p99, 100000u);
+
+    histogram.clear();
+    EXPECT_EQ(histogram.count(), 0u);
+}
+
+TEST(GameServer_Serve, AnswersAScriptedClientOverPipes) {
+    int requests[2], responses[2];
+    ASSERT_EQ(pipe(requests), 0);
+    ASSERT_EQ(pipe(responses), 0);
+
+    // Split mid-line to exercise the partial-line buffer
+    std::thread client([&] {
+        const char* script[] = {"NEW a 2 2 0\nNEW b 2 2 0\nREV", "EAL a 0 0\nSTATS\nQUIT\nREVEAL b 0 0\n"};
+        for (const char* part : script) {
+            ASSERT_GT(write(requests[1], part, strlen(part)), 0);
+        }
+        close(requests[1]);
+    });
+
+    GameServer server(2);
+    EXPECT_EQ(server.serve(requests[0], responses[1]), 0);
+    client.join();
+    close(responses[1]);
+
+    std::string output;
+    char buffer[256];
+    ssize_t n;
+    while ((n = read(responses[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, static_cast<size_t>(n));
+    }
+    close(requests[0]);
+    close(responses[0]);
+
+    // Nothing after QUIT runs
+    ASSERT_EQ(output.rfind("OK a\nOK b\nDIFF a won 4 0R0 1R0 2R0 3R0\nOK stats games=2 requests=", 0), 0u);
+    EXPECT_EQ(output.substr(output.size() - 8), "\nOK bye\n");
+    EXPECT_EQ(server.latency().count(), 5u);
+}
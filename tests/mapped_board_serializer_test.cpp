@@ -0,0 +1,188 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/mapped_board_serializer_test.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "minesweeper/mapped_board_serializer.hpp"
+#include "minesweeper/board.hpp"
+
+namespace {
+    std::shared_ptr<ISerializable> mapped() {
+        return std::make_shared<MappedBoardSerializer>();
+    }
+
+    // Save `board` in the mappable format to a fresh temp file
+    std::string saveToTemp(Board& board, const std::string& name) {
+        std::string path = testing::TempDir() + name;
+        std::ofstream out(path, std::ios::binary);
+        EXPECT_EQ(board.save(out), 0);
+        return path;
+    }
+
+    // First safe tile in row-major order
+    Cell firstSafe(Board& board) {
+        for (int r = 0; r < board.getRows(); ++r)
+            for (int c = 0; c < board.getColumns(); ++c)
+                if (!board.getTile(r, c)->isMine) return {r, c};
+        return {0, 0};
+    }
+}
+
+TEST(MappedSerializer_Stream, SaveThenLoadRoundTrip) {
+    Board original(30, 40, 150, uint64_t{3}, mapped());
+    original.toggleTile(2, 2);
+    Cell safe = firstSafe(original);
+    original.revealTile(safe.row, safe.col);
+
+    std::stringstream buffer;
+    ASSERT_EQ(original.save(buffer), 0);
+    EXPECT_EQ(buffer.str().size(), sizeof(MappedBoardHeader) + 32u * 42u);   // tiles plus sentinel border
+
+    Board restored(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(restored.load(buffer), 0);
+    EXPECT_TRUE(restored == original);
+    EXPECT_EQ(restored.minesRemaining(), original.minesRemaining());
+}
+
+TEST(MappedSerializer_Attach, PrivateAttachNeverChangesTheFile) {
+    Board original(30, 40, 150, uint64_t{4}, mapped());
+    original.toggleTile(0, 0);
+    std::string path = saveToTemp(original, "private_attach.msw");
+
+    Board attached(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(attached.attach(path, false), 0);
+    EXPECT_TRUE(attached.isAttached());
+    EXPECT_TRUE(attached == original);
+    EXPECT_EQ(attached.minesRemaining(), original.minesRemaining());
+
+    // Play on the private mapping, then re-attach: the file is untouched
+    Cell safe = firstSafe(attached);
+    attached.revealTile(safe.row, safe.col);
+    ASSERT_EQ(attached.sync(), 0);
+
+    Board again(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(again.attach(path, false), 0);
+    EXPECT_TRUE(again == original);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSerializer_Attach, InPlaceMovesAndCountersReachTheFile) {
+    Board original(30, 40, 150, uint64_t{5}, mapped());
+    std::string path = saveToTemp(original, "inplace_attach.msw");
+
+    Board playing(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(playing.attach(path, true), 0);
+    playing.toggleTile(1, 1);
+    Cell safe = firstSafe(playing);
+    playing.revealTile(safe.row, safe.col);
+    ASSERT_EQ(playing.sync(), 0);
+
+    Board reopened(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(reopened.attach(path, false), 0);
+    EXPECT_TRUE(reopened == playing);
+    EXPECT_EQ(reopened.minesRemaining(), original.getMines() - 1);
+    EXPECT_EQ(reopened.getTile(safe.row, safe.col)->state, TileState::REVEALED);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSerializer_Attach, CopiesAndResetsDetach) {
+    Board original(10, 10, 10, uint64_t{6}, mapped());
+    std::string path = saveToTemp(original, "copy_attach.msw");
+
+    Board playing(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(playing.attach(path, true), 0);
+
+    // A copy owns its tiles, so moves on it never reach the file
+    Board copy = playing;
+    EXPECT_FALSE(copy.isAttached());
+    copy.toggleTile(0, 0);
+    EXPECT_EQ(playing.getTile(0, 0)->state, TileState::COVERED);
+
+    playing.reset(10, 10, 10);
+    EXPECT_FALSE(playing.isAttached());
+    std::remove(path.c_str());
+}
+
+TEST(MappedSerializer_Attach, RejectsMissingAndForeignFiles) {
+    Board board(5, 5, 1, uint64_t{1}, mapped());
+    EXPECT_EQ(board.attach(testing::TempDir() + "does_not_exist.msw", false), -1);
+
+    std::string path = testing::TempDir() + "foreign.msw";
+    {
+        std::ofstream out(path);
+        out << "5 5 1\nnot a mapped board at all, just some text padding it out to 64+ bytes\n";
+    }
+    EXPECT_EQ(board.attach(path, false), -1);
+    EXPECT_FALSE(board.isAttached());
+    EXPECT_EQ(board.getRows(), 5);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSerializer_Attach, RebuildsCountersFromTheTiles) {
+    Board original(6, 7, 5, uint64_t{8}, mapped());
+    original.toggleTile(0, 0);
+    std::string path = saveToTemp(original, "edited_counters.msw");
+    {
+        // Claim an explosion and no flags in the header
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        MappedBoardHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.flagged = 0;
+        header.exploded = 1;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    Board board(5, 5, 1, uint64_t{1}, mapped());
+    ASSERT_EQ(board.attach(path, false), 0);
+    EXPECT_FALSE(board.isLost());
+    EXPECT_EQ(board.minesRemaining(), 4);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSerializer_Attach, RejectsMoreMinesThanTiles) {
+    Board original(6, 7, 5, uint64_t{8}, mapped());
+    std::string path = saveToTemp(original, "too_many_mines.msw");
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        MappedBoardHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.mines = 43;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    Board board(5, 5, 1, uint64_t{1}, mapped());
+    EXPECT_EQ(board.attach(path, false), -1);
+    std::ifstream in(path, std::ios::binary);
+    EXPECT_EQ(board.load(in), -1);
+    std::remove(path.c_str());
+}
+
+TEST(MappedSerializer_Attach, RejectsADamagedSentinelBorder) {
+    Board original(6, 7, 5, uint64_t{8}, mapped());
+    std::string path = saveToTemp(original, "damaged_border.msw");
+    {
+        // Turn the left sentinel of row 3 into a covered tile
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(MappedBoardHeader) + (3 + 1) * (7 + 2));
+        char covered = 0;
+        file.write(&covered, 1);
+    }
+    Board board(5, 5, 1, uint64_t{1}, mapped());
+    EXPECT_EQ(board.attach(path, false), -1);
+    EXPECT_FALSE(board.isAttached());
+    EXPECT_EQ(board.getRows(), 5);
+
+    std::ifstream in(path, std::ios::binary);
+    EXPECT_EQ(board.load(in), -1);
+    EXPECT_EQ(board.getRows(), 5);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,110 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/mine_bitboard_test.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "minesweeper/mine_bitboard.hpp"
+#include "minesweeper/tile.hpp"
+
+namespace {
+    // Straightforward 8-neighbor count used as the reference
+    unsigned bruteCount(const std::vector<Tile>& tiles, int rows, int cols, int r, int c) {
+        unsigned count = 0;
+        for (int dr = -1; dr <= 1; dr++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                if (dr == 0 && dc == 0) continue;
+                int nr = r + dr, nc = c + dc;
+                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols && tiles[nr * cols + nc].isMine) count++;
+            }
+        }
+        return count;
+    }
+
+    std::vector<Tile> randomTiles(int rows, int cols, unsigned seed, int oneIn) {
+        std::mt19937 rng(seed);
+        std::vector<Tile> tiles(rows * cols);
+        for (Tile& t : tiles) {
+            t.isMine = (rng() % oneIn) == 0;
+            t.state = static_cast<TileState>(rng() % 5);
+        }
+        return tiles;
+    }
+
+    void expectMatchesBruteForce(int rows, int cols, bool useSimd) {
+        for (int oneIn : {2, 5, 40}) {
+            std::vector<Tile> tiles = randomTiles(rows, cols, rows * 1000 + cols + oneIn, oneIn);
+            std::vector<Tile> before = tiles;
+
+            MineBitboard bits;
+            bits.load(tiles.data(), rows, cols, cols);
+            bits.writeAdjacents(tiles.data(), cols, useSimd);
+
+            for (int r = 0; r < rows; r++) {
+                for (int c = 0; c < cols; c++) {
+                    const Tile& t = tiles[r * cols + c];
+                    EXPECT_EQ(bits.isMine(r, c), before[r * cols + c].isMine);
+                    EXPECT_EQ(t.state, before[r * cols + c].state);
+                    EXPECT_EQ(t.isMine, before[r * cols + c].isMine);
+                    unsigned expected = t.isMine ? 0u : bruteCount(tiles, rows, cols, r, c);
+                    ASSERT_EQ(t.adjacentMines, expected)
+                        << rows << "x" << cols << " at (" << r << "," << c << ")";
+                }
+            }
+        }
+    }
+}
+
+TEST(MineBitboard_Counts, ScalarMatchesBruteForce) {
+    for (auto [rows, cols] : {std::pair{1, 1}, {1, 9}, {3, 64}, {7, 65}, {33, 130}, {16, 30}, {20, 257}}) {
+        expectMatchesBruteForce(rows, cols, false);
+    }
+}
+
+TEST(MineBitboard_Counts, SimdMatchesBruteForce) {
+    if (!MineBitboard::simdAvailable()) {
+        GTEST_SKIP() << "AVX2 not available on this CPU";
+    }
+    for (auto [rows, cols] : {std::pair{1, 1}, {5, 256}, {7, 320}, {9, 511}, {16, 30}}) {
+        expectMatchesBruteForce(rows, cols, true);
+    }
+}
+
+TEST(MineBitboard_Counts, AllMinesAndNoMines) {
+    std::vector<Tile> tiles(10 * 70);
+    MineBitboard bits;
+    bits.load(tiles.data(), 10, 70, 70);
+    bits.writeAdjacents(tiles.data(), 70);
+    for (const Tile& t : tiles) EXPECT_EQ(t.adjacentMines, 0u);
+
+    for (Tile& t : tiles) t.isMine = true;
+    bits.load(tiles.data(), 10, 70, 70);
+    bits.writeAdjacents(tiles.data(), 70);
+    for (const Tile& t : tiles) EXPECT_EQ(t.adjacentMines, 0u); // mines are left untouched
+}
+
+TEST(MineBitboard_Counts, BandsWithHaloMatchTheWholeBoard) {
+    const int rows = 23, cols = 70;
+    std::vector<Tile> tiles = randomTiles(rows, cols, 99, 3);
+    std::vector<Tile> whole = tiles;
+    MineBitboard bits;
+    bits.load(whole.data(), rows, cols, cols);
+    bits.writeAdjacents(whole.data(), cols);
+
+    for (int first = 0; first < rows; first += 5) {
+        int count = std::min(5, rows - first);
+        Tile* top = &tiles[first * cols];
+        bits.load(top, count, cols, cols, first > 0 ? top - cols : nullptr,
+                  first + count < rows ? top + count * cols : nullptr);
+        bits.writeAdjacents(top, cols);
+    }
+    for (int i = 0; i < rows * cols; i++) {
+        ASSERT_EQ(tiles[i].adjacentMines, whole[i].adjacentMines) << "tile " << i;
+    }
+}
@@ -0,0 +1,98 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/move_history_test.cpp
+#include <gtest/gtest.h>
+#include <vector>
+#include "minesweeper/move_history.hpp"
+
+namespace {
+    Tile revealed() {
+        Tile tile;
+        tile.state = TileState::REVEALED;
+        return tile;
+    }
+
+    // Record one move that changes tiles[first, first + count) to REVEALED
+    void play(MoveHistory& history, std::vector<Tile>& tiles, int first, int count) {
+        history.begin();
+        for (int i = first; i < first + count; i++) {
+            history.note(i, tiles[i]);
+            tiles[i] = revealed();
+        }
+        history.commit(tiles.data());
+    }
+}
+
+TEST(MoveHistory_Steps, UndoAndRedoReturnEachMovesChanges) {
+    std::vector<Tile> tiles(16);
+    MoveHistory history(4);
+    play(history, tiles, 0, 3);
+    play(history, tiles, 3, 5);
+
+    const MoveHistory::Change* first = nullptr;
+    size_t count = 0;
+    ASSERT_TRUE(history.undo(first, count));
+    EXPECT_EQ(count, 5u);
+    EXPECT_EQ(first[0].index, 3);
+    EXPECT_EQ(first[0].before.state, TileState::COVERED);
+    EXPECT_EQ(first[0].after.state, TileState::REVEALED);
+    ASSERT_TRUE(history.undo(first, count));
+    EXPECT_EQ(count, 3u);
+    EXPECT_FALSE(history.undo(first, count));
+
+    ASSERT_TRUE(history.redo(first, count));
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(history.undoable(), 1u);
+    EXPECT_EQ(history.redoable(), 1u);
+}
+
+TEST(MoveHistory_Steps, EmptyMovesKeepTheRedoMoves) {
+    std::vector<Tile> tiles(8);
+    MoveHistory history(4);
+    play(history, tiles, 0, 2);
+    const MoveHistory::Change* first;
+    size_t count;
+    ASSERT_TRUE(history.undo(first, count));
+
+    play(history, tiles, 0, 0);
+    EXPECT_EQ(history.redoable(), 1u);
+
+    // A real move replaces them, and its changes take their place
+    play(history, tiles, 4, 3);
+    EXPECT_EQ(history.redoable(), 0u);
+    ASSERT_TRUE(history.undo(first, count));
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(first[0].index, 4);
+}
+
+TEST(MoveHistory_Depth, KeepsTheNewestMoves) {
+    std::vector<Tile> tiles(64);
+    MoveHistory history(3);
+    for (int m = 0; m < 10; m++) {
+        play(history, tiles, m * 6, m % 4 + 1);
+    }
+    EXPECT_EQ(history.undoable(), 3u);
+    const MoveHistory::Change* first;
+    size_t count;
+    for (int m = 9; m >= 7; m--) {
+        ASSERT_TRUE(history.undo(first, count));
+        EXPECT_EQ(first[0].index, m * 6);
+        EXPECT_EQ(count, static_cast<size_t>(m % 4 + 1));
+    }
+    EXPECT_FALSE(history.undo(first, count));
+
+    // Shrinking with nothing left to undo drops the newest redo moves
+    history.setDepth(1);
+    ASSERT_TRUE(history.redo(first, count));
+    EXPECT_EQ(first[0].index, 7 * 6);
+    EXPECT_FALSE(history.redo(first, count));
+
+    history.setDepth(0);
+    EXPECT_FALSE(history.enabled());
+    EXPECT_EQ(history.undoable() + history.redoable(), 0u);
+}
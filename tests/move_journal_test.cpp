@@ -0,0 +1,138 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/move_journal_test.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "minesweeper/move_journal.hpp"
+#include "minesweeper/board.hpp"
+
+namespace {
+    struct JournalFiles {
+        std::string base;
+        std::string journal;
+        explicit JournalFiles(const std::string& name) :
+            base(testing::TempDir() + name + ".txt"), journal(testing::TempDir() + name + ".journal") {}
+        ~JournalFiles() {
+            std::remove(base.c_str());
+            std::remove(journal.c_str());
+        }
+    };
+
+    // Play a few moves on `board`, journaling each one
+    void playSomeMoves(Board& board, MoveJournal& journal) {
+        for (int i = 0; i < 12; ++i) {
+            int r = (i * 7) % board.getRows(), c = (i * 11) % board.getColumns();
+            if (i % 3 == 0) {
+                board.toggleTile(r, c);
+                journal.record(board, MOVE_TOGGLE, r, c);
+            } else if (!board.getTile(r, c)->isMine) {
+                board.revealTile(r, c);
+                journal.record(board, MOVE_REVEAL, r, c);
+            }
+        }
+    }
+
+    long fileSize(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return static_cast<long>(in.tellg());
+    }
+}
+
+TEST(MoveJournal_Replay, RestoreReproducesTheGame) {
+    JournalFiles files("replay");
+    Board board(16, 30, 99, uint64_t{21});
+    MoveJournal journal(files.base, files.journal);
+    ASSERT_EQ(journal.begin(board), 0);
+    long baseSize = fileSize(files.base);
+
+    playSomeMoves(board, journal);
+    EXPECT_GT(journal.length(), 0u);
+    // Moves only append to the journal, the base is untouched
+    EXPECT_EQ(fileSize(files.base), baseSize);
+    EXPECT_EQ(fileSize(files.journal), 8 + 9 * static_cast<long>(journal.length()));
+
+    Board restored(5, 5, 1);
+    MoveJournal reopened(files.base, files.journal);
+    ASSERT_EQ(reopened.restore(restored), 0);
+    EXPECT_TRUE(restored == board);
+    EXPECT_EQ(restored.minesRemaining(), board.minesRemaining());
+    EXPECT_EQ(reopened.length(), journal.length());
+}
+
+TEST(MoveJournal_Replay, CompactionFoldsMovesIntoBase) {
+    JournalFiles files("compact");
+    Board board(16, 30, 99, uint64_t{22});
+    MoveJournal journal(files.base, files.journal, 4);
+    ASSERT_EQ(journal.begin(board), 0);
+
+    playSomeMoves(board, journal);
+    EXPECT_LT(journal.length(), 4u);
+
+    Board restored(5, 5, 1);
+    MoveJournal reopened(files.base, files.journal, 4);
+    ASSERT_EQ(reopened.restore(restored), 0);
+    EXPECT_TRUE(restored == board);
+}
+
+TEST(MoveJournal_Replay, TornLastRecordIsIgnored) {
+    JournalFiles files("torn");
+    Board board(9, 9, 10, uint64_t{23});
+    MoveJournal journal(files.base, files.journal);
+    ASSERT_EQ(journal.begin(board), 0);
+    board.toggleTile(0, 0);
+    journal.record(board, MOVE_TOGGLE, 0, 0);
+    Board expected = board;
+    board.toggleTile(1, 1);
+    journal.record(board, MOVE_TOGGLE, 1, 1);
+
+    // Simulate a crash half-way through writing the second record
+    std::filesystem::resize_file(files.journal, fileSize(files.journal) - 4);
+
+    Board restored(5, 5, 1);
+    MoveJournal reopened(files.base, files.journal);
+    ASSERT_EQ(reopened.restore(restored), 0);
+    EXPECT_TRUE(restored == expected);
+    EXPECT_EQ(reopened.length(), 1u);
+
+    // Appending continues cleanly after the last good record
+    restored.toggleTile(2, 2);
+    reopened.record(restored, MOVE_TOGGLE, 2, 2);
+    Board again(5, 5, 1);
+    MoveJournal third(files.base, files.journal);
+    ASSERT_EQ(third.restore(again), 0);
+    EXPECT_TRUE(again == restored);
+}
+
+TEST(MoveJournal_Replay, ReplaysChords) {
+    JournalFiles files("chord");
+    Board board(6, 6, std::vector<Cell>{{0, 0}, {5, 5}});
+    MoveJournal journal(files.base, files.journal);
+    ASSERT_EQ(journal.begin(board), 0);
+    board.revealTile(1, 1);
+    journal.record(board, MOVE_REVEAL, 1, 1);
+    board.toggleTile(0, 0);
+    journal.record(board, MOVE_TOGGLE, 0, 0);
+    board.chordTile(1, 1);
+    journal.record(board, MOVE_CHORD, 1, 1);
+
+    Board restored(5, 5, 1);
+    MoveJournal reopened(files.base, files.journal);
+    ASSERT_EQ(reopened.restore(restored), 0);
+    EXPECT_TRUE(restored == board);
+    EXPECT_EQ(restored.getTile(3, 3)->state, TileState::REVEALED);
+}
+
+TEST(MoveJournal_Replay, MissingBaseFails) {
+    JournalFiles files("missing");
+    Board board(5, 5, 1);
+    MoveJournal journal(files.base, files.journal);
+    EXPECT_EQ(journal.restore(board), -1);
+}
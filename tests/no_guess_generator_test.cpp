@@ -0,0 +1,91 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/no_guess_generator_test.cpp
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "minesweeper/board.hpp"
+#include "minesweeper/no_guess_generator.hpp"
+#include "minesweeper/solver.hpp"
+#include "minesweeper/thread_pool.hpp"
+
+namespace {
+    // Clear the board from `click` using only solver-proven moves
+    bool solvesWithoutGuessing(Board& board, Cell click) {
+        Solver solver(board);
+        std::vector<Cell> changed;
+        board.revealTile(click.row, click.col, changed);
+        while (!board.isWon() && !board.isLost()) {
+            solver.update(changed);
+            solver.solve();
+            Cell safe;
+            if (!solver.nextSafe(safe)) {
+                return false;
+            }
+            changed.clear();
+            board.revealTile(safe.row, safe.col, changed);
+        }
+        return board.isWon();
+    }
+}
+
+TEST(NoGuessGenerator_Generate, ExpertBoardNeedsNoGuess) {
+    NoGuessGenerator generator;
+    std::vector<Cell> mines;
+    Cell click = {8, 15};
+    ASSERT_EQ(generator.generate(16, 30, 99, click, 2024, mines), 0);
+    EXPECT_GE(generator.attempts(), 1u);
+
+    Board board(16, 30, mines);
+    EXPECT_EQ(board.getMines(), 99);
+    for (const Cell& m : mines) {
+        EXPECT_FALSE(std::abs(m.row - click.row) <= 1 && std::abs(m.col - click.col) <= 1);
+    }
+    EXPECT_TRUE(solvesWithoutGuessing(board, click));
+}
+
+TEST(NoGuessGenerator_Generate, SameBoardForAnyPoolSize) {
+    ThreadPool pool(3);
+    NoGuessGenerator serial;
+    NoGuessGenerator parallel(&pool);
+    std::vector<Cell> a, b;
+    for (uint64_t seed = 1; seed <= 5; seed++) {
+        ASSERT_EQ(serial.generate(9, 9, 10, {0, 0}, seed, a), 0);
+        ASSERT_EQ(parallel.generate(9, 9, 10, {0, 0}, seed, b), 0);
+        EXPECT_TRUE(Board(9, 9, a) == Board(9, 9, b)) << "seed " << seed;
+    }
+}
+
+TEST(NoGuessGenerator_Generate, GenerateFromAPoolTaskDoesNotDeadlock) {
+    ThreadPool pool(2);
+    NoGuessGenerator serial;
+    NoGuessGenerator parallel(&pool);
+    std::vector<Cell> a, b;
+    int status = -1;
+    pool.submit([&parallel, &b, &status] {
+        status = parallel.generate(9, 9, 10, {0, 0}, 3, b);
+    });
+    pool.wait();
+    ASSERT_EQ(status, 0);
+    ASSERT_EQ(serial.generate(9, 9, 10, {0, 0}, 3, a), 0);
+    EXPECT_TRUE(Board(9, 9, a) == Board(9, 9, b));
+}
+
+TEST(NoGuessGenerator_Generate, ImpossibleRequestsFail) {
+    NoGuessGenerator generator;
+    std::vector<Cell> mines;
+    // 5x5 with the click in the middle leaves 16 tiles outside its 3x3
+    EXPECT_EQ(generator.generate(5, 5, 17, {2, 2}, 1, mines), -1);
+
+    // On a single row nothing past the first mine can be proven, so only the
+    // layout with all mines at the far end passes (1 in 3276); the attempt
+    // limit stops the search first
+    generator.setMaxAttempts(50);
+    EXPECT_EQ(generator.generate(1, 30, 3, {0, 0}, 1, mines), -1);
+    EXPECT_EQ(generator.attempts(), 50u);
+}
@@ -0,0 +1,176 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/probability_engine_test.cpp
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "minesweeper/board.hpp"
+#include "minesweeper/probability_engine.hpp"
+#include "minesweeper/thread_pool.hpp"
+
+namespace {
+    // Reference answer: try every placement of the remaining mines on the
+    // covered, unflagged tiles and keep those matching every revealed count
+    std::vector<double> bruteForce(Board& board) {
+        int rows = board.getRows();
+        int columns = board.getColumns();
+        std::vector<int> covered;
+        int flags = 0;
+        for (int i = 0; i < rows * columns; i++) {
+            TileState state = board.getTile(i / columns, i % columns)->state;
+            if (state == COVERED) {
+                covered.push_back(i);
+            }
+            flags += state == FLAGGED;
+        }
+        int minesLeft = board.getMines() - flags;
+        std::vector<double> hits(rows * columns, 0.0);
+        double layouts = 0.0;
+        for (uint32_t mask = 0; mask < (1u << covered.size()); mask++) {
+            if (__builtin_popcount(mask) != minesLeft) {
+                continue;
+            }
+            std::vector<int> mine(rows * columns, 0);
+            for (size_t k = 0; k < covered.size(); k++) {
+                mine[covered[k]] = (mask >> k) & 1;
+            }
+            for (int i = 0; i < rows * columns; i++) {
+                mine[i] |= board.getTile(i / columns, i % columns)->state == FLAGGED;
+            }
+            bool fits = true;
+            for (int r = 0; r < rows && fits; r++) {
+                for (int c = 0; c < columns && fits; c++) {
+                    if (board.getTile(r, c)->state != REVEALED) {
+                        continue;
+                    }
+                    int around = 0;
+                    for (int dr = -1; dr <= 1; dr++) {
+                        for (int dc = -1; dc <= 1; dc++) {
+                            if ((dr || dc) && board.inBounds(r + dr, c + dc)) {
+                                around += mine[(r + dr) * columns + c + dc];
+                            }
+                        }
+                    }
+                    fits = around == board.getTile(r, c)->adjacentMines;
+                }
+            }
+            if (fits) {
+                layouts++;
+                for (int i = 0; i < rows * columns; i++) {
+                    hits[i] += mine[i];
+                }
+            }
+        }
+        for (double& h : hits) {
+            h /= layouts;
+        }
+        return hits;
+    }
+
+    // Reveal safe tiles (in a fixed scattered order) until at most
+    // `maxCovered` tiles are covered
+    void openUntil(Board& board, int maxCovered) {
+        int cells = board.getRows() * board.getColumns();
+        for (int step = 0, i = 0; step < cells; step++, i = (i + 7) % cells) {
+            int covered = 0;
+            for (int j = 0; j < cells; j++) {
+                covered += board.getTile(j / board.getColumns(), j % board.getColumns())->state == COVERED;
+            }
+            if (covered <= maxCovered) {
+                return;
+            }
+            Tile* t = board.getTile(i / board.getColumns(), i % board.getColumns());
+            if (!t->isMine) {
+                board.revealTile(i / board.getColumns(), i % board.getColumns());
+            }
+        }
+    }
+}
+
+TEST(ProbabilityEngine_Exact, MatchesBruteForce) {
+    for (uint64_t seed = 1; seed <= 12; seed++) {
+        Board board(6, 6, 7, seed);
+        openUntil(board, 16);
+        if (board.isWon()) {
+            continue;
+        }
+        ProbabilityEngine engine;
+        MineProbabilities probs;
+        ASSERT_EQ(engine.compute(board, probs), 0);
+        EXPECT_TRUE(probs.exact);
+        std::vector<double> expected = bruteForce(board);
+        for (int i = 0; i < 36; i++) {
+            EXPECT_NEAR(probs.mine[i], expected[i], 1e-9) << "seed " << seed << " tile " << i;
+        }
+    }
+}
+
+TEST(ProbabilityEngine_Exact, FlagsAndPoolGiveTheSameAnswer) {
+    Board board(6, 6, 7, uint64_t{5});
+    openUntil(board, 16);
+    for (int i = 0; i < 36; i++) {
+        if (board.getTile(i / 6, i % 6)->isMine) {
+            board.toggleTile(i / 6, i % 6);     // flag one real mine
+            break;
+        }
+    }
+    ThreadPool pool(3);
+    ProbabilityEngine serial;
+    ProbabilityEngine parallel(&pool);
+    MineProbabilities a, b;
+    ASSERT_EQ(serial.compute(board, a), 0);
+    ASSERT_EQ(parallel.compute(board, b), 0);
+    std::vector<double> expected = bruteForce(board);
+    for (int i = 0; i < 36; i++) {
+        EXPECT_NEAR(a.mine[i], expected[i], 1e-9) << i;
+        EXPECT_DOUBLE_EQ(a.mine[i], b.mine[i]) << i;
+    }
+}
+
+TEST(ProbabilityEngine_Exact, ComputesFromTasksOnItsOwnPool) {
+    // Every worker busy in compute(): each call must finish on its own
+    Board board(16, 16, 40, uint64_t{9});
+    board.revealTile(8, 8);
+    openUntil(board, 120);
+    ThreadPool pool(2);
+    ProbabilityEngine first(&pool), second(&pool);
+    MineProbabilities a, b;
+    int ra = -1, rb = -1;
+    pool.submit([&] { ra = first.compute(board, a); });
+    pool.submit([&] { rb = second.compute(board, b); });
+    pool.wait();
+    EXPECT_EQ(ra, 0);
+    EXPECT_EQ(rb, 0);
+    EXPECT_EQ(a.mine, b.mine);
+}
+
+TEST(ProbabilityEngine_Fallback, ZeroBudgetApproximates) {
+    Board board(30, 30, 150, uint64_t{3});
+    board.revealTile(15, 15);
+    openUntil(board, 700);
+    ProbabilityEngine engine;
+    engine.setTimeBudget(0.0);
+    MineProbabilities probs;
+    EXPECT_EQ(engine.compute(board, probs), 0);
+    EXPECT_FALSE(probs.exact);
+    for (double p : probs.mine) {
+        EXPECT_GE(p, 0.0);
+        EXPECT_LE(p, 1.0);
+    }
+}
+
+TEST(ProbabilityEngine_Fallback, WrongFlagIsAContradiction) {
+    std::istringstream layout("2 2 1\n* .\n. .\n");
+    Board board(layout);
+    board.revealTile(1, 1);
+    board.toggleTile(0, 1);     // flags a safe tile: the 1 at (1,1) is now used up
+    board.toggleTile(0, 0);     // ... and so is the real mine, making two
+    ProbabilityEngine engine;
+    MineProbabilities probs;
+    EXPECT_EQ(engine.compute(board, probs), -1);
+}
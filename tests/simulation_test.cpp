@@ -0,0 +1,118 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/simulation_test.cpp
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include "minesweeper/simulation.hpp"
+#include "minesweeper/thread_pool.hpp"
+
+namespace {
+    StrategyFactory randomFactory() {
+        return [] { return std::unique_ptr<Strategy>(new RandomStrategy()); };
+    }
+
+    SimulationConfig smallConfig() {
+        SimulationConfig cfg;
+        cfg.rows = 9;
+        cfg.columns = 9;
+        cfg.mines = 10;
+        cfg.games = 500;
+        cfg.seed = 42;
+        return cfg;
+    }
+}
+
+TEST(ThreadPool_Tasks, WaitRunsEveryTask) {
+    ThreadPool pool(3);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 100; i++) {
+        pool.submit([&done] { done++; });
+    }
+    pool.wait();
+    EXPECT_EQ(done.load(), 100);
+    EXPECT_EQ(pool.size(), 3u);
+}
+
+TEST(ThreadPool_Tasks, ParallelForWaitsOnlyForItsOwnWork) {
+    ThreadPool pool(2);
+    std::mutex gate;
+    std::unique_lock<std::mutex> held(gate);
+    pool.submit([&gate] { std::lock_guard<std::mutex> wait(gate); });   // blocks a worker
+
+    std::atomic<int> sum(0);
+    pool.parallelFor(100, [&sum](size_t i) { sum += static_cast<int>(i); });
+    EXPECT_EQ(sum.load(), 4950);
+    held.unlock();
+    pool.wait();
+}
+
+TEST(ThreadPool_Tasks, ParallelForFromAWorkerDoesNotDeadlock) {
+    ThreadPool pool(1);
+    std::atomic<int> sum(0);
+    pool.submit([&pool, &sum] {
+        pool.parallelFor(10, [&sum](size_t i) { sum += static_cast<int>(i); });
+    });
+    pool.wait();
+    EXPECT_EQ(sum.load(), 45);
+}
+
+TEST(Simulator_Run, EveryGameIsTallied) {
+    ThreadPool pool(2);
+    SimulationResult res = Simulator(smallConfig(), randomFactory()).run(pool);
+
+    EXPECT_EQ(res.games, 500u);
+    EXPECT_EQ(res.wins + res.losses + res.resigned, res.games);
+    uint64_t histogramGames = 0;
+    for (uint64_t n : res.revealHistogram) {
+        histogramGames += n;
+    }
+    EXPECT_EQ(histogramGames, res.games);
+    EXPECT_EQ(res.revealHistogram[0], 0u) << "every game makes at least one reveal";
+    EXPECT_GT(res.losses, 0u) << "random clicking on 10/81 mines loses sometimes";
+}
+
+TEST(Simulator_Run, ResultsDoNotDependOnThreadCount) {
+    ThreadPool one(1);
+    ThreadPool three(3);
+    SimulationResult a = Simulator(smallConfig(), randomFactory()).run(one);
+    SimulationResult b = Simulator(smallConfig(), randomFactory()).run(three);
+
+    EXPECT_EQ(a.wins, b.wins);
+    EXPECT_EQ(a.losses, b.losses);
+    EXPECT_EQ(a.revealHistogram, b.revealHistogram);
+}
+
+TEST(Simulator_Run, RunFromAPoolTaskDoesNotDeadlock) {
+    ThreadPool pool(2);
+    SimulationResult nested;
+    pool.submit([&pool, &nested] {
+        nested = Simulator(smallConfig(), randomFactory()).run(pool);
+    });
+    pool.wait();
+
+    ThreadPool other(2);
+    SimulationResult direct = Simulator(smallConfig(), randomFactory()).run(other);
+    EXPECT_EQ(nested.games, 500u);
+    EXPECT_EQ(nested.wins, direct.wins);
+    EXPECT_EQ(nested.revealHistogram, direct.revealHistogram);
+}
+
+TEST(Simulator_Run, SingleGameIsReproducible) {
+    SimulationConfig cfg = smallConfig();
+    uint64_t seed = Simulator::gameSeed(cfg.seed, 7);
+    Board first(cfg.rows, cfg.columns, cfg.mines, seed);
+    Board second(cfg.rows, cfg.columns, cfg.mines, uint64_t{1});
+    second.reset(cfg.rows, cfg.columns, cfg.mines, seed);
+    RandomStrategy s1, s2;
+    SimulationResult r1, r2;
+
+    EXPECT_EQ(Simulator::playGame(first, s1, 99, r1), Simulator::playGame(second, s2, 99, r2));
+    EXPECT_EQ(r1.wins, r2.wins);
+    EXPECT_TRUE(first == second);
+}
@@ -0,0 +1,112 @@
+/*                                       
+ *   _____ _                                       
+ *  |     |_|___ ___ ___ _ _ _ ___ ___ ___ ___ ___ 
+ *  | | | | |   | -_|_ -| | | | -_| -_| . | -_|  _|
+ *  |_|_|_|_|_|_|___|___|_____|___|___|  _|___|_|  
+ *                                  |_|          
+ */
+// tests/solver_test.cpp
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "minesweeper/board.hpp"
+#include "minesweeper/solver.hpp"
+
+namespace {
+    // Play `board` with the solver, guessing (row-major first unknown tile)
+    // only when nothing is proven.  Every deduction is checked against the
+    // real mine layout on the way.
+    void playChecked(Board& board, Solver& solver) {
+        std::vector<Cell> changed;
+        while (!board.isWon() && !board.isLost()) {
+            solver.solve();
+            for (const Cell& m : solver.minesFound()) {
+                ASSERT_TRUE(board.getTile(m.row, m.col)->isMine) << m.row << "," << m.col;
+            }
+            Cell next;
+            if (solver.nextSafe(next)) {
+                ASSERT_FALSE(board.getTile(next.row, next.col)->isMine) << next.row << "," << next.col;
+            } else {
+                bool found = false;
+                for (int i = 0; i < board.getRows() * board.getColumns() && !found; i++) {
+                    next = {i / board.getColumns(), i % board.getColumns()};
+                    found = board.getTile(next.row, next.col)->state == COVERED &&
+                            solver.deduction(next.row, next.col) == DEDUCED_UNKNOWN;
+                }
+                ASSERT_TRUE(found);
+            }
+            changed.clear();
+            board.revealTile(next.row, next.col, changed);
+            solver.update(changed);
+        }
+    }
+}
+
+TEST(Solver_Rules, PairRuleSolvesOneTwoOne) {
+    std::istringstream layout("3 3 2\n* . *\n. . .\n. . .\n");
+    Board board(layout);
+    board.revealTile(2, 1);     // opens rows 1-2: counts 1 2 1 under a covered row
+    Solver solver(board);
+    solver.solve();
+
+    EXPECT_EQ(solver.deduction(0, 0), DEDUCED_MINE);
+    EXPECT_EQ(solver.deduction(0, 1), DEDUCED_SAFE);
+    EXPECT_EQ(solver.deduction(0, 2), DEDUCED_MINE);
+    Cell safe;
+    ASSERT_TRUE(solver.nextSafe(safe));
+    EXPECT_EQ(safe.row, 0);
+    EXPECT_EQ(safe.col, 1);
+    EXPECT_FALSE(solver.nextSafe(safe));
+}
+
+TEST(Solver_Rules, FlagsCountAsMines) {
+    std::istringstream layout("2 2 1\n* .\n. .\n");
+    Board board(layout);
+    board.revealTile(1, 1);     // count 1 over three covered tiles
+    board.toggleTile(0, 0);
+    Solver solver(board);
+    solver.solve();
+
+    EXPECT_EQ(solver.deduction(0, 1), DEDUCED_SAFE);
+    EXPECT_EQ(solver.deduction(1, 0), DEDUCED_SAFE);
+    EXPECT_EQ(solver.deduction(0, 0), DEDUCED_UNKNOWN) << "a flag is a player fact, not a deduction";
+}
+
+TEST(Solver_Incremental, DeductionsAreSound) {
+    for (uint64_t seed = 1; seed <= 20; seed++) {
+        Board board(30, 30, 150, seed);
+        Solver solver(board);
+        playChecked(board, solver);
+    }
+}
+
+TEST(Solver_Incremental, MatchesAFullRescan) {
+    Board board(40, 40, 250, uint64_t{7});
+    Solver incremental(board);
+    std::vector<Cell> changed;
+    // A few reveals chosen by the solver itself, then compare with a fresh solve
+    board.revealTile(20, 20, changed);
+    for (int move = 0; move < 30 && !board.isLost() && !board.isWon(); move++) {
+        incremental.update(changed);
+        incremental.solve();
+        Cell next;
+        if (!incremental.nextSafe(next)) {
+            break;
+        }
+        changed.clear();
+        board.revealTile(next.row, next.col, changed);
+    }
+    incremental.update(changed);
+    incremental.solve();
+
+    Solver full(board);
+    full.solve();
+    for (int r = 0; r < board.getRows(); r++) {
+        for (int c = 0; c < board.getColumns(); c++) {
+            if (board.getTile(r, c)->state != COVERED) {
+                continue;   // revealed tiles keep their old SAFE mark incrementally
+            }
+            EXPECT_EQ(incremental.deduction(r, c), full.deduction(r, c)) << r << "," << c;
+        }
+    }
+}